@@ -0,0 +1,139 @@
+// Allocation policies for the heaps
+// Each heap takes one of these as a template template parameter and instantiates it once for every node type it uses
+// Example: pairing<int, arenaallocator> pq;
+// A policy provides allocate() which returns a zero-initialised node, deallocate() which gives a node back,
+// and merge() which takes ownership of the memory of another allocator when two heaps are merged
+#ifndef HEAPS_ALLOCATOR
+#define HEAPS_ALLOCATOR
+template<class N> struct newallocator // Allocates every node individually with new. Default, the original behaviour
+{
+	N* allocate()
+	{
+		return new N();
+	}
+	void deallocate(N* a)
+	{
+		delete a;
+	}
+	void merge(newallocator &) // Nodes are independent of the allocator, nothing to do
+	{
+	}
+};
+template<class N> struct arenaallocator // Growable slab. Nodes are carved out of blocks that double in size
+{	// Blocks are only released when the allocator (i.e. the heap) is destroyed
+	struct block
+	{
+		N* nodes;
+		block* next;
+	};
+	block* blocks = nullptr; // Linked list of blocks, newest first
+	block* oldest = nullptr; // Last block in the list, so lists can be spliced in O(1)
+	int upto = 0, cap = 0; // Number of nodes used in, and size of, the newest block
+	arenaallocator()
+	{
+	}
+	arenaallocator(const arenaallocator&) = delete; // A block is owned by exactly one allocator
+	arenaallocator& operator=(const arenaallocator&) = delete;
+	~arenaallocator()
+	{
+		while (blocks)
+		{
+			block* next = blocks->next;
+			delete[] blocks->nodes;
+			delete blocks;
+			blocks = next;
+		}
+	}
+	N* allocate()
+	{
+		if (upto == cap) // Newest block is full, make one twice the size
+		{
+			cap = cap ? 2*cap : 16; // Small first block, heaps are often tiny (e.g. one per vertex in Edmonds)
+			block* b = new block();
+			b->nodes = new N[cap](); // Value-initialised, so nodes are zeroed
+			b->next = blocks;
+			if (!blocks) oldest = b;
+			blocks = b;
+			upto = 0;
+		}
+		return blocks->nodes + upto++;
+	}
+	void deallocate(N*) // Memory is reclaimed when the allocator is destroyed
+	{
+	}
+	void merge(arenaallocator &a) // Takes ownership of all of a's blocks
+	{
+		if (!a.blocks) return;
+		if (!blocks) // Take a's newest block as our newest block as well
+		{
+			blocks = a.blocks;
+			oldest = a.oldest;
+			upto = a.upto;
+			cap = a.cap;
+		}
+		else // Splice a's blocks in after our newest block, which we keep allocating from
+		{
+			a.oldest->next = blocks->next;
+			if (oldest == blocks) oldest = a.oldest;
+			blocks->next = a.blocks;
+		}
+		a.blocks = a.oldest = nullptr;
+		a.upto = a.cap = 0;
+	}
+};
+template<class N> struct freelistallocator : arenaallocator<N> // Arena that recycles deallocated nodes before carving out new ones
+{
+	N** freed = nullptr; // Stack of deallocated nodes
+	int freedsz = 0, freedcap = 0;
+	freelistallocator()
+	{
+	}
+	~freelistallocator()
+	{
+		delete[] freed;
+	}
+	void reserve(int n) // Makes the stack of deallocated nodes hold at least n nodes
+	{
+		if (n <= freedcap) return;
+		while (freedcap < n) freedcap = freedcap ? 2*freedcap : 64;
+		N** _new = new N*[freedcap];
+		for (int i = 0; i < freedsz; i++) _new[i] = freed[i];
+		delete[] freed;
+		freed = _new;
+	}
+	N* allocate()
+	{
+		if (freedsz) // Reuse a node, clearing it first
+		{
+			N* a = freed[--freedsz];
+			*a = N();
+			return a;
+		}
+		return arenaallocator<N>::allocate();
+	}
+	void deallocate(N* a)
+	{
+		if (freedsz == freedcap) reserve(freedsz+1);
+		freed[freedsz++] = a;
+	}
+	void merge(freelistallocator &a) // Takes ownership of a's blocks and of the nodes it has deallocated
+	{
+		arenaallocator<N>::merge(a);
+		if (a.freedsz > freedsz) // Copy the smaller stack into the larger one, so repeated merges stay cheap
+		{
+			N** f = freed;
+			freed = a.freed;
+			a.freed = f;
+			int n = freedsz;
+			freedsz = a.freedsz;
+			a.freedsz = n;
+			n = freedcap;
+			freedcap = a.freedcap;
+			a.freedcap = n;
+		}
+		reserve(freedsz + a.freedsz);
+		for (int i = 0; i < a.freedsz; i++) freed[freedsz++] = a.freed[i];
+		a.freedsz = 0;
+	}
+};
+#endif
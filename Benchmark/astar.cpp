@@ -0,0 +1,118 @@
+// A* search for the point to point queries of query.cpp, on a graph whose vertices have coordinates (e.g. from Dijkstra/genplanar.cpp)
+// The heap is keyed by the distance from s plus the straight-line distance to t, so the search is drawn towards t
+// The straight-line distance is scaled by the smallest ratio of an edge's weight to its length, so the heuristic is consistent for any
+// weights (genplanar rounds lengths down). Settled vertices are then never improved, and each vertex is pushed and popped at most once
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+struct placedqueryset : queryset // Queries on a graph with the coordinates of its vertices
+{
+	std::vector<double> x, y;
+	double scale = 1; // Straight-line distance times scale is at most the weight of any path
+	placedqueryset(graph &g, int queries, ll seed) : queryset(g, queries, seed)
+	{
+	}
+	double length(int a, int b)
+	{
+		return std::hypot(x[a] - x[b], y[a] - y[b]);
+	}
+	bool readcoordinates(const char* filename) // v, then the x and y of each vertex. Returns false if they do not match the graph
+	{
+		FILE* f = fopen(filename, "r");
+		if (!f) return false;
+		int v;
+		bool ok = fscanf(f, "%d", &v) == 1 && v == adj->v;
+		if (ok)
+		{
+			x.resize(v);
+			y.resize(v);
+		}
+		for (int i = 0; i < v && ok; i++) ok = fscanf(f, "%lf%lf", &x[i], &y[i]) == 2;
+		fclose(f);
+		if (!ok) return false;
+		for (int a = 0; a < adj->v; a++)
+		{
+			for (ll j = adj->offsets[a]; j < adj->offsets[a+1]; j++)
+			{
+				double l = length(a, adj->targets[j]);
+				if (l > 0) scale = std::min(scale, adj->weights[j] / l);
+			}
+		}
+		scale = std::max(scale, 0.0) * (1 - 1e-9); // Leaves room for rounding
+		return true;
+	}
+};
+template<class H> struct astarquery
+{
+	placedqueryset &q;
+	dijkstraquery<H> search; // Its distances are from s, its keys add the heuristic
+	ll* h; // Heuristic of each vertex reached in this query
+	int t;
+	opcounts &ops;
+	astarquery(placedqueryset &_q) : q(_q), search(*_q.adj), ops(search.ops)
+	{
+		h = new ll[q.adj->v];
+	}
+	~astarquery()
+	{
+		delete[] h;
+	}
+	void relax(H &pq, int b, ll d) // Reaches b at distance d from s, if that is shorter
+	{
+		if (!search.reached(b))
+		{
+			h[b] = q.length(b, t) * q.scale;
+			search.dist[b] = d;
+			search.stamp[b] = search.now;
+			search.nodes[b] = pq.push(std::make_pair(d + h[b], b));
+			ops.push++;
+		}
+		else if (d < search.dist[b])
+		{
+			search.dist[b] = d;
+			pq.decreasekey(search.nodes[b], std::make_pair(d + h[b], b));
+			ops.decreasekey++;
+		}
+	}
+	ll query(int s, int _t) // Distance from s to t
+	{
+		const csrgraph &g = *q.adj;
+		t = _t;
+		search.next();
+		H pq;
+		relax(pq, s, 0);
+		while (!pq.empty())
+		{
+			int a = pq.top().second;
+			if (a == t) return search.dist[t];
+			pq.pop();
+			ops.pop++;
+			for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++) relax(pq, g.targets[j], search.dist[a] + g.weights[j]);
+		}
+		return 1e18;
+	}
+};
+struct astarqueries
+{
+	static constexpr const char* name = "astar";
+	placedqueryset &q;
+	opcounts ops;
+	astarqueries(placedqueryset &_q) : q(_q)
+	{
+	}
+	template<class K> bool supports()
+	{
+		return true;
+	}
+	template<class K> ll run(timer &t)
+	{
+		astarquery<typename K::template heap<heapvalue<std::pair<ll, int> > > > engine(q);
+		unsigned long long sum = 0; // Wraps around
+		t.start();
+		for (const std::pair<int, int> &p : q.pairs) sum += engine.query(p.first, p.second);
+		t.stop();
+		ops = engine.ops;
+		return sum;
+	}
+};
@@ -0,0 +1,258 @@
+// Runs an algorithm with one heap, or every heap, on a graph read from stdin
+// Usage: ./benchmark algorithm heap [runs] [-format text|csv|json] [-seed n] [-queries n] [-coords file] [-perf] [-latency] [-trace file] < input
+// algorithm is dijkstra, dijkstra-lazy, dijkstra-query, bidirectional, astar, stoer-wagner or edmonds, heap is the name of a heap or all
+// dijkstra-lazy pushes each vertex when it is first reached, instead of pushing every vertex up front
+// dijkstra-query answers point to point queries, stopping each search at its target (see query.cpp)
+// bidirectional answers the same queries with a search from each end (see bidirectional.cpp)
+// astar answers them with A*, using the coordinates of the vertices, read from the file given with -coords (see astar.cpp)
+// algorithm can also be replay, which reads a trace of heap operations from stdin instead of a graph (see trace.cpp)
+// Each heap is run the given number of times (default 5)
+// text summarises the times of the runs in nanoseconds, csv and json print a record for every run (see record.cpp)
+// seed is the seed the input was generated with, it is only copied into the records, and generates the queries (default 1)
+// queries is the number of random queries, without it the only query is from 0 to v-1
+// perf reads hardware performance counters around the timed region: cycles, instructions, L1D, LLC, branch and dTLB misses
+// latency times every push, pop, decreasekey and merge instead, and prints percentiles of each over all the runs (see latency.cpp)
+// trace runs the heap once, and writes the operations the algorithm did on it to file instead
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "heaps.cpp"
+#include "graph.cpp"
+#include "timer.cpp"
+#include "record.cpp"
+#include "latency.cpp"
+#include "trace.cpp"
+#include "dijkstra.cpp"
+#include "query.cpp"
+#include "bidirectional.cpp"
+#include "astar.cpp"
+#include "stoerwagner.cpp"
+#include "edmonds.cpp"
+#include "replay.cpp"
+struct options
+{
+	int runs = 5;
+	recordformat format = formattext;
+	ll seed = -1;
+	perfcounters* perf = nullptr; // Set by -perf
+	bool latency = false;
+	const char* tracefile = nullptr;
+	int queries = 0; // For the point to point algorithms
+	const char* coordinates = nullptr; // For A*
+};
+template<class A> struct runner // Runs algorithm A with every heap it is given, and prints its records
+{
+	A &algorithm;
+	int v, e; // Size of the input, for the records
+	options &opt;
+	bool unsupported = false; // Set if a heap was asked for by name that cannot run the algorithm
+	runner(A &a, int _v, int _e, options &o) : algorithm(a), v(_v), e(_e), opt(o)
+	{
+	}
+	template<class K> void run()
+	{
+		if (!algorithm.template supports<K>())
+		{
+			unsupported = true;
+			return;
+		}
+		if (opt.tracefile)
+		{
+			recordtrace<K>();
+			return;
+		}
+		if (opt.latency)
+		{
+			latency<K>();
+			return;
+		}
+		record* records = new record[opt.runs];
+		ll* times = new ll[opt.runs];
+		bool consistent = true; // Whether every run gave the same answer
+		resetpeakrss();
+		for (int r = 0; r < opt.runs; r++)
+		{
+			timer t;
+			t.perf = opt.perf;
+			record &rec = records[r];
+			rec.algorithm = A::name;
+			rec.heap = K::name;
+			rec.v = v;
+			rec.e = e;
+			rec.seed = opt.seed;
+			rec.run = r;
+#ifdef HEAPS_COUNTERS
+			_heapcounters = heapcounters();
+#endif
+			rec.answer = algorithm.template run<K>(t);
+			rec.time = times[r] = t.elapsed;
+			rec.ops = algorithm.ops;
+			for (int i = 0; i < perfevents; i++) rec.events[i] = t.events[i];
+#ifdef HEAPS_COUNTERS
+			rec.counters = _heapcounters;
+#endif
+			if (r && rec.answer != records[0].answer) consistent = false;
+		}
+		ll rss = peakrss();
+		for (int r = 0; r < opt.runs; r++)
+		{
+			records[r].peakrss = rss;
+			printrecord(opt.format, records[r], opt.perf);
+		}
+		if (opt.format == formattext)
+		{
+			runstats s(times, opt.runs);
+			printf("%-14s %-16s %5d %20lld %14lld %14lld %14.0f %14lld %12.0f %12lld%s\n", A::name, K::name, opt.runs, records[0].answer,
+				s.min, s.median, s.mean, s.max, s.stddev, rss, consistent ? "" : " (answers differ between runs)");
+			if (opt.perf) printperf(records, opt.runs);
+#ifdef HEAPS_COUNTERS
+			printcounters(records[0].counters);
+#endif
+		}
+		else if (!consistent) fprintf(stderr, "%s %s: answers differ between runs\n", A::name, K::name);
+		fflush(stdout);
+		delete[] records;
+		delete[] times;
+	}
+	template<class K> void latency() // Runs K with its operations timed, and prints the percentiles of each kind of operation
+	{
+		for (int i = 0; i < 4; i++) _latency[i].clear();
+		for (int r = 0; r < opt.runs; r++)
+		{
+			timer t;
+			algorithm.template run<timedkind<K> >(t);
+		}
+		printlatency(opt.format, A::name, K::name, v, e, opt.seed);
+		fflush(stdout);
+	}
+	template<class K> void recordtrace() // Runs K once, and writes its operations to the trace file
+	{
+		tracewriter w;
+		_tracing = &w;
+		timer t;
+		algorithm.template run<tracedkind<K> >(t);
+		_tracing = nullptr;
+		if (w.save(opt.tracefile)) fprintf(stderr, "Wrote %lld operations on %lld heaps to %s\n", w.operations, w.heaps, opt.tracefile);
+		else fprintf(stderr, "Cannot write %s\n", opt.tracefile);
+	}
+};
+template<class A, class I> int benchmark(I &input, int v, int e, const char* heap, options &opt) // Runs A, constructed from input of size v, e
+{
+	A algorithm(input);
+	runner<A> r(algorithm, v, e, opt);
+	if (opt.tracefile)
+	{
+		if (!strcmp(heap, "all"))
+		{
+			fprintf(stderr, "A trace is recorded with one heap\n");
+			return 1;
+		}
+	}
+	else if (opt.latency) printlatencyheader(opt.format);
+	else if (opt.format == formattext)
+	{
+		printf("%-14s %-16s %5s %20s %14s %14s %14s %14s %12s %12s\n", "algorithm", "heap", "runs", "answer",
+			"min(ns)", "median(ns)", "mean(ns)", "max(ns)", "stddev(ns)", "peakrss(kB)");
+	}
+	else printheader(opt.format, opt.perf);
+	if (!allheaps::forheaps(heap, r))
+	{
+		fprintf(stderr, "Unknown heap %s, the heaps are:", heap);
+		allheaps::printnames(stderr);
+		return 1;
+	}
+	if (r.unsupported && strcmp(heap, "all"))
+	{
+		fprintf(stderr, "%s cannot run %s\n", heap, A::name);
+		return 1;
+	}
+	return 0;
+}
+int usage(const char* name)
+{
+	fprintf(stderr, "Usage: %s algorithm heap [runs] [-format text|csv|json] [-seed n] [-queries n] [-coords file] [-perf] [-latency] [-trace file] < input\n", name);
+	fprintf(stderr, "The algorithms are: dijkstra dijkstra-lazy dijkstra-query bidirectional astar stoer-wagner edmonds replay\n");
+	fprintf(stderr, "The heaps are: all");
+	allheaps::printnames(stderr);
+	return 1;
+}
+int main(int argc, char* argv[])
+{
+	if (argc < 3) return usage(argv[0]);
+	options opt;
+	for (int i = 3; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-format") && i+1 < argc)
+		{
+			i++;
+			if (!strcmp(argv[i], "text")) opt.format = formattext;
+			else if (!strcmp(argv[i], "csv")) opt.format = formatcsv;
+			else if (!strcmp(argv[i], "json")) opt.format = formatjson;
+			else return usage(argv[0]);
+		}
+		else if (!strcmp(argv[i], "-seed") && i+1 < argc) opt.seed = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-queries") && i+1 < argc) opt.queries = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-coords") && i+1 < argc) opt.coordinates = argv[++i];
+		else if (!strcmp(argv[i], "-latency")) opt.latency = true;
+		else if (!strcmp(argv[i], "-trace") && i+1 < argc) opt.tracefile = argv[++i];
+		else if (!strcmp(argv[i], "-perf"))
+		{
+			if (!opt.perf) opt.perf = new perfcounters();
+		}
+		else if (i == 3 && argv[i][0] != '-') opt.runs = atoi(argv[i]);
+		else return usage(argv[0]);
+	}
+	if (opt.runs < 1) opt.runs = 1;
+	if (opt.perf && !opt.perf->available()) fprintf(stderr, "Hardware performance counters are not available (see /proc/sys/kernel/perf_event_paranoid), they are reported as -1\n");
+	if (opt.latency)
+	{
+		latencyclock::calibrate();
+		fprintf(stderr, "Each latency includes about %.1fns of reading the clock\n", latencyclock::overhead());
+	}
+	if (!strcmp(argv[1], "replay"))
+	{
+		trace tr;
+		if (!tr.read(stdin))
+		{
+			fprintf(stderr, "Malformed trace\n");
+			return 1;
+		}
+		return benchmark<replay>(tr, tr.handles, tr.ops.size(), argv[2], opt);
+	}
+	graph g;
+	if (!g.read(stdin))
+	{
+		fprintf(stderr, "Malformed input\n");
+		return 1;
+	}
+	if (!strcmp(argv[1], "dijkstra")) return benchmark<dijkstra>(g, g.v, g.e, argv[2], opt);
+	if (!strcmp(argv[1], "dijkstra-lazy")) return benchmark<lazydijkstra>(g, g.v, g.e, argv[2], opt);
+	if (!strcmp(argv[1], "dijkstra-query") || !strcmp(argv[1], "bidirectional"))
+	{
+		queryset q(g, opt.queries, opt.seed < 0 ? 1 : opt.seed);
+		if (!strcmp(argv[1], "bidirectional")) return benchmark<bidirectionalqueries>(q, g.v, g.e, argv[2], opt);
+		return benchmark<pointqueries>(q, g.v, g.e, argv[2], opt);
+	}
+	if (!strcmp(argv[1], "astar"))
+	{
+		placedqueryset q(g, opt.queries, opt.seed < 0 ? 1 : opt.seed);
+		if (!opt.coordinates || !q.readcoordinates(opt.coordinates))
+		{
+			fprintf(stderr, "astar needs the coordinates of the vertices, with -coords file\n");
+			return 1;
+		}
+		return benchmark<astarqueries>(q, g.v, g.e, argv[2], opt);
+	}
+	if (!strcmp(argv[1], "stoer-wagner")) return benchmark<stoerwagner>(g, g.v, g.e, argv[2], opt);
+	if (!strcmp(argv[1], "edmonds"))
+	{
+		if (g.symmetric)
+		{
+			fprintf(stderr, "edmonds needs a directed graph, not one converted with tocsr -undirected\n");
+			return 1;
+		}
+		return benchmark<edmonds>(g, g.v, g.e, argv[2], opt);
+	}
+	fprintf(stderr, "Unknown algorithm %s\n", argv[1]);
+	return usage(argv[0]);
+}
@@ -0,0 +1,71 @@
+// Bidirectional Dijkstra for the point to point queries of query.cpp: a forward search from s and a backward search from t,
+// each with its own heap, the side whose top is smaller is advanced. Every edge scanned from one side to a vertex reached by the other
+// is a path, and the search stops once the two tops add up to at least the shortest of them, which is then the distance
+// As the graph is undirected, the backward search uses the same edges
+#include <utility>
+#include <algorithm>
+template<class H> struct bidirectionalquery
+{
+	dijkstraquery<H> forward, backward;
+	opcounts ops;
+	bidirectionalquery(const csrgraph &g) : forward(g), backward(g)
+	{
+	}
+	ll step(dijkstraquery<H> &side, H &pq, dijkstraquery<H> &other, ll best) // Settles the top of pq, returns the shortest path found
+	{
+		const csrgraph &g = side.g;
+		std::pair<ll, int> a = pq.top();
+		pq.pop();
+		side.ops.pop++;
+		for (ll j = g.offsets[a.second]; j < g.offsets[a.second+1]; j++)
+		{
+			int b = g.targets[j];
+			ll d = a.first + g.weights[j];
+			side.relax(pq, b, d);
+			if (other.reached(b)) best = std::min(best, d + other.dist[b]);
+		}
+		return best;
+	}
+	ll query(int s, int t) // Distance from s to t
+	{
+		if (s == t) return 0;
+		forward.next();
+		backward.next();
+		H pf, pb;
+		forward.relax(pf, s, 0);
+		backward.relax(pb, t, 0);
+		ll best = 1e18;
+		while (!pf.empty() && !pb.empty() && pf.top().first + pb.top().first < best)
+		{
+			if (pf.top().first <= pb.top().first) best = step(forward, pf, backward, best);
+			else best = step(backward, pb, forward, best);
+		}
+		ops.push = forward.ops.push + backward.ops.push;
+		ops.pop = forward.ops.pop + backward.ops.pop;
+		ops.decreasekey = forward.ops.decreasekey + backward.ops.decreasekey;
+		return best;
+	}
+};
+struct bidirectionalqueries
+{
+	static constexpr const char* name = "bidirectional";
+	queryset &q;
+	opcounts ops;
+	bidirectionalqueries(queryset &_q) : q(_q)
+	{
+	}
+	template<class K> bool supports()
+	{
+		return true;
+	}
+	template<class K> ll run(timer &t)
+	{
+		bidirectionalquery<typename K::template heap<heapvalue<std::pair<ll, int> > > > engine(*q.adj);
+		unsigned long long sum = 0; // Wraps around
+		t.start();
+		for (const std::pair<int, int> &p : q.pairs) sum += engine.query(p.first, p.second);
+		t.stop();
+		ops = engine.ops;
+		return sum;
+	}
+};
@@ -0,0 +1,125 @@
+// Compares two sets of benchmark records in CSV (./benchmark ... -format csv) and flags regressions
+// Usage: ./compare baseline.csv candidate.csv [threshold]
+// Runs are grouped by algorithm, heap, v, e and seed, and the median times of the groups are compared
+// A group regresses if its median time grows by more than threshold percent (default 5), or if its answer changes
+// Returns 1 if any group regressed, so it can be used as a gate
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+using namespace std;
+typedef long long ll;
+struct group // All runs of one heap on one input
+{
+	vector<ll> times;
+	ll answer = 0;
+	ll peakrss = -1;
+	bool consistent = true; // Whether every run gave the same answer
+	ll median()
+	{
+		sort(times.begin(), times.end());
+		int n = times.size();
+		return n%2 ? times[n/2] : (times[n/2-1] + times[n/2])/2;
+	}
+};
+vector<string> split(const char* line) // Splits a CSV line, fields do not contain commas
+{
+	vector<string> fields(1);
+	for (const char* c = line; *c && *c != '\n' && *c != '\r'; c++)
+	{
+		if (*c == ',') fields.emplace_back();
+		else fields.back() += *c;
+	}
+	return fields;
+}
+bool read(const char* filename, map<string, group> &groups) // Returns false if the file cannot be read
+{
+	FILE* f = fopen(filename, "r");
+	if (!f)
+	{
+		fprintf(stderr, "Cannot open %s\n", filename);
+		return false;
+	}
+	char line[4096];
+	if (!fgets(line, sizeof(line), f))
+	{
+		fprintf(stderr, "%s is empty\n", filename);
+		fclose(f);
+		return false;
+	}
+	// Find the columns by name, so columns can be added later
+	vector<string> header = split(line);
+	map<string, int> column;
+	for (int i = 0; i < (int)header.size(); i++) column[header[i]] = i;
+	const char* needed[] = {"algorithm", "heap", "v", "e", "seed", "answer", "time_ns"};
+	for (const char* c : needed)
+	{
+		if (!column.count(c))
+		{
+			fprintf(stderr, "%s has no %s column\n", filename, c);
+			fclose(f);
+			return false;
+		}
+	}
+	while (fgets(line, sizeof(line), f))
+	{
+		vector<string> fields = split(line);
+		if (fields.size() != header.size()) continue; // Another header, or a broken line
+		if (fields[column["algorithm"]] == "algorithm") continue;
+		string key = fields[column["algorithm"]] + " " + fields[column["heap"]] + " v=" + fields[column["v"]] + " e=" + fields[column["e"]] + " seed=" + fields[column["seed"]];
+		group &g = groups[key];
+		ll answer = atoll(fields[column["answer"]].c_str());
+		if (!g.times.empty() && answer != g.answer) g.consistent = false;
+		g.answer = answer;
+		g.times.push_back(atoll(fields[column["time_ns"]].c_str()));
+		if (column.count("peakrss_kb")) g.peakrss = max(g.peakrss, atoll(fields[column["peakrss_kb"]].c_str()));
+	}
+	fclose(f);
+	return true;
+}
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: %s baseline.csv candidate.csv [threshold]\n", argv[0]);
+		return 2;
+	}
+	double threshold = argc > 3 ? atof(argv[3]) : 5;
+	map<string, group> base, cand;
+	if (!read(argv[1], base) || !read(argv[2], cand)) return 2;
+	int regressions = 0;
+	printf("%-60s %14s %14s %9s %12s %12s\n", "group", "base(ns)", "new(ns)", "change", "base(kB)", "new(kB)");
+	for (auto &c : cand)
+	{
+		auto b = base.find(c.first);
+		if (b == base.end())
+		{
+			printf("%-60s %14s %14lld %9s %12s %12lld  new\n", c.first.c_str(), "-", c.second.median(), "-", "-", c.second.peakrss);
+			continue;
+		}
+		ll bm = b->second.median(), cm = c.second.median();
+		double change = bm ? 100.0*(cm - bm)/bm : 0;
+		const char* flag = "";
+		if (!c.second.consistent || !b->second.consistent || c.second.answer != b->second.answer)
+		{
+			flag = "  ANSWER CHANGED";
+			regressions++;
+		}
+		else if (change > threshold)
+		{
+			flag = "  REGRESSION";
+			regressions++;
+		}
+		else if (change < -threshold) flag = "  faster";
+		printf("%-60s %14lld %14lld %+8.1f%% %12lld %12lld%s\n", c.first.c_str(), bm, cm, change, b->second.peakrss, c.second.peakrss, flag);
+	}
+	for (auto &b : base)
+	{
+		if (!cand.count(b.first)) printf("%-60s %14lld %14s %9s %12lld %12s  missing\n", b.first.c_str(), b.second.median(), "-", "-", b.second.peakrss, "-");
+	}
+	printf("%d regression%s (threshold %.1f%%)\n", regressions, regressions == 1 ? "" : "s", threshold);
+	return regressions ? 1 : 0;
+}
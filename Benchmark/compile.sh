@@ -0,0 +1,14 @@
+# Compiles the benchmarks and the comparison tool
+g++ -std=c++17 -O2 -march=native -o benchmark benchmark.cpp
+g++ -std=c++17 -O2 -o compare compare.cpp
+# Converts text graphs to the binary format (see README)
+g++ -std=c++17 -O2 -o tocsr tocsr.cpp
+g++ -std=c++17 -O2 -march=native -o heapsort heapsort.cpp
+# With the scalar loop instead of SIMD in the d-ary heap, to measure what SIMD gains (see README)
+g++ -std=c++17 -O2 -march=native -DDARY_SCALAR -o heapsort_scalar heapsort.cpp
+# With the heaps' instrumentation counters (see README), not for timing
+g++ -std=c++17 -O2 -march=native -DHEAPS_COUNTERS -o benchmark_counters benchmark.cpp
+# Concurrent priority queues (see README)
+g++ -std=c++17 -O2 -march=native -pthread -o concurrent concurrent.cpp
+# Differential fuzzer of the heaps (see README)
+g++ -std=c++17 -O2 -march=native -o fuzz fuzz.cpp
@@ -0,0 +1,263 @@
+// Concurrent priority queues built from the heaps: throughput and rank error
+// Usage: ./concurrent heap [threads] [-ops n] [-prefill n] [-push p] [-c n] [-seed n]
+// heap is the name of a heap, skiplist or all. Each heap is run as a MultiQueue (../MultiQueue/multiqueue.cpp) of c * threads heaps (default c = 2),
+// and behind a single mutex as the baseline, skiplist is the lock-free queue of ../Skiplist/skiplist.cpp. They are run with 1, 2, 4, ... threads
+// up to threads (default: every core)
+// The queue is filled with prefill random keys (default 1000000), then every thread does ops operations (default 1000000), each a push of a
+// random key with probability p percent (default 50), otherwise a pop. Throughput is in millions of operations per second
+// The rank error of a pop is the number of keys in the queue smaller than the one it returned, 0 for an exact priority queue
+// It is measured in a second run where every operation is timestamped, replaying the operations in timestamp order. Pushes are stamped
+// before they start and pops after they finish, so a key a pop could not have seen yet may be counted, which only overestimates the error
+// Keys are unique, and the count, sum and xor of the keys popped are checked against those of the keys pushed, so a lost or duplicated key
+// would have to be cancelled out in all three at once to go unnoticed
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+typedef long long ll;
+#include "heaps.cpp"
+#include "../MultiQueue/multiqueue.cpp"
+#include "../Skiplist/skiplist.cpp"
+template<class T, class H> struct lockedheap // A heap behind a mutex, the obvious way to share one
+{
+	std::mutex m;
+	H heap;
+	lockedheap(int, int)
+	{
+	}
+	void push(T val)
+	{
+		std::lock_guard<std::mutex> l(m);
+		heap.push(val);
+	}
+	bool pop(T &val)
+	{
+		std::lock_guard<std::mutex> l(m);
+		if (heap.empty()) return false;
+		val = heap.top();
+		heap.pop();
+		return true;
+	}
+};
+template<class T> struct sharedskiplist : skiplist<T> // Lock-free, so there is nothing to set up per thread
+{
+	sharedskiplist(int, int)
+	{
+	}
+};
+struct options
+{
+	int threads = std::thread::hardware_concurrency();
+	ll ops = 1000000; // Per thread
+	ll prefill = 1000000;
+	int push = 50; // Percentage of operations that are pushes
+	int c = 2;
+	ll seed = 1;
+};
+struct keytally // Of a set of keys
+{
+	ll count = 0;
+	unsigned long long sum = 0, x = 0; // Sum wraps around
+	void add(ll k)
+	{
+		count++;
+		sum += k;
+		x ^= k;
+	}
+	void add(const keytally &b)
+	{
+		count += b.count;
+		sum += b.sum;
+		x ^= b.x;
+	}
+	bool operator==(const keytally &b) const
+	{
+		return count == b.count && sum == b.sum && x == b.x;
+	}
+};
+struct event // An operation of the timestamped run
+{
+	ll time;
+	bool pop;
+	ll key;
+};
+struct concurrent
+{
+	options &opt;
+	concurrent(options &o) : opt(o)
+	{
+	}
+	ll key(std::mt19937_64 &rng, ll id) // Random, made unique by the low 32 bits, so every pop can be matched to its push
+	{
+		return (ll)(rng() >> 34) << 32 | id;
+	}
+	static ll now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	template<class Q, bool timestamped> void work(Q &q, int id, std::atomic<bool> &go, std::vector<event> &events, keytally &popped)
+	{
+		std::mt19937_64 rng(opt.seed * 1000003 + id + 1);
+		ll next = opt.prefill + id * opt.ops; // Ids of this thread's keys
+		popped = keytally();
+		while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+		for (ll i = 0; i < opt.ops; i++)
+		{
+			if ((int)(rng() % 100) < opt.push)
+			{
+				ll k = key(rng, next++);
+				if (timestamped) events.push_back({now(), false, k});
+				q.push(k);
+			}
+			else
+			{
+				ll k;
+				if (!q.pop(k)) continue;
+				popped.add(k);
+				if (timestamped) events.push_back({now(), true, k});
+			}
+		}
+	}
+	template<class Q, bool timestamped> double run(int threads, std::vector<std::vector<event> > &events, bool &consistent) // Returns the time in seconds
+	{
+		Q q(threads, opt.c);
+		std::mt19937_64 rng(opt.seed);
+		keytally all; // Of every key pushed, to check each is popped once
+		for (ll i = 0; i < opt.prefill; i++)
+		{
+			ll k = key(rng, i);
+			q.push(k);
+			all.add(k);
+			if (timestamped) events[threads].push_back({0, false, k});
+		}
+		std::atomic<bool> go{false};
+		std::vector<keytally> popped(threads);
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; t++) pool.emplace_back([&, t]() { work<Q, timestamped>(q, t, go, events[t], popped[t]); });
+		ll start = now();
+		go.store(true, std::memory_order_release);
+		for (std::thread &t : pool) t.join();
+		double seconds = (now() - start) / 1e9;
+		// Every key pushed by the threads is regenerated, as the threads' generators are seeded the same way
+		keytally rest;
+		ll k;
+		while (q.pop(k)) rest.add(k);
+		for (int t = 0; t < threads; t++)
+		{
+			std::mt19937_64 r(opt.seed * 1000003 + t + 1);
+			ll next = opt.prefill + t * opt.ops;
+			for (ll i = 0; i < opt.ops; i++) if ((int)(r() % 100) < opt.push) all.add(key(r, next++));
+			rest.add(popped[t]);
+		}
+		consistent = all == rest;
+		return seconds;
+	}
+	void rankerror(std::vector<std::vector<event> > &events, double &mean, ll &max) // Replays the timestamped operations
+	{
+		std::vector<event> all;
+		for (std::vector<event> &e : events) all.insert(all.end(), e.begin(), e.end());
+		std::stable_sort(all.begin(), all.end(), [](const event &a, const event &b)
+		{
+			return a.time < b.time || (a.time == b.time && !a.pop && b.pop);
+		});
+		std::vector<ll> keys;
+		for (const event &e : all) if (!e.pop) keys.push_back(e.key);
+		std::sort(keys.begin(), keys.end());
+		std::vector<int> tree(keys.size() + 1); // Fenwick tree of the keys in the queue
+		auto add = [&](size_t i, int d)
+		{
+			for (i++; i < tree.size(); i += i & -i) tree[i] += d;
+		};
+		auto below = [&](size_t i) // Keys in the queue smaller than keys[i]
+		{
+			ll s = 0;
+			for (; i > 0; i -= i & -i) s += tree[i];
+			return s;
+		};
+		ll pops = 0, sum = 0;
+		max = 0;
+		for (const event &e : all)
+		{
+			size_t i = std::lower_bound(keys.begin(), keys.end(), e.key) - keys.begin();
+			if (!e.pop)
+			{
+				add(i, 1);
+				continue;
+			}
+			ll r = below(i);
+			sum += r;
+			max = std::max(max, r);
+			pops++;
+			add(i, -1);
+		}
+		mean = pops ? (double)sum / pops : 0;
+	}
+	template<class Q> void measure(const char* structure, const char* heap)
+	{
+		for (int threads = 1; ; threads = std::min(2*threads, opt.threads))
+		{
+			std::vector<std::vector<event> > events(threads + 1); // The last is the prefill
+			bool consistent, stampedconsistent;
+			double seconds = run<Q, false>(threads, events, consistent);
+			for (int t = 0; t < threads; t++) events[t].reserve(opt.ops);
+			run<Q, true>(threads, events, stampedconsistent);
+			double mean;
+			ll max;
+			rankerror(events, mean, max);
+			printf("%-12s %-16s %7d %12.2f %14.1f %12lld%s\n", structure, heap, threads, threads * opt.ops / seconds / 1e6, mean, max,
+				consistent && stampedconsistent ? "" : " (keys lost or duplicated)");
+			fflush(stdout);
+			if (threads == opt.threads) break;
+		}
+	}
+	template<class K> void run()
+	{
+		typedef typename K::template heap<ll> heap;
+		measure<lockedheap<ll, heap> >("mutex", K::name);
+		measure<multiqueue<ll, heap> >("multiqueue", K::name);
+	}
+};
+int usage(const char* name)
+{
+	fprintf(stderr, "Usage: %s heap [threads] [-ops n] [-prefill n] [-push p] [-c n] [-seed n]\n", name);
+	fprintf(stderr, "The heaps are: all skiplist");
+	allheaps::printnames(stderr);
+	return 1;
+}
+int main(int argc, char* argv[])
+{
+	if (argc < 2) return usage(argv[0]);
+	options opt;
+	for (int i = 2; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-ops") && i+1 < argc) opt.ops = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-prefill") && i+1 < argc) opt.prefill = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-push") && i+1 < argc) opt.push = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-c") && i+1 < argc) opt.c = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-seed") && i+1 < argc) opt.seed = atoll(argv[++i]);
+		else if (i == 2 && argv[i][0] != '-') opt.threads = atoi(argv[i]);
+		else return usage(argv[0]);
+	}
+	if (opt.threads < 1) opt.threads = 1;
+	if (opt.ops < 1 || opt.prefill < 0 || opt.push < 0 || opt.push > 100 || opt.c < 1 || opt.prefill + opt.threads * opt.ops >= 1ll << 32)
+	{
+		fprintf(stderr, "prefill + threads * ops must be less than 2^32\n");
+		return usage(argv[0]);
+	}
+	concurrent c(opt);
+	printf("%-12s %-16s %7s %12s %14s %12s\n", "structure", "heap", "threads", "Mops/s", "mean rank", "max rank");
+	bool skip = !strcmp(argv[1], "skiplist");
+	if (skip || !strcmp(argv[1], "all")) c.measure<sharedskiplist<ll> >("skiplist", "-");
+	if (!skip && !allheaps::forheaps(argv[1], c))
+	{
+		fprintf(stderr, "Unknown heap %s\n", argv[1]);
+		return usage(argv[0]);
+	}
+	return 0;
+}
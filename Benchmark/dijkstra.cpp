@@ -0,0 +1,118 @@
+// Dijkstra's algorithm from vertex 0 on an undirected graph, the answer is the distance to vertex v-1
+// Every vertex is pushed up front, as in the drivers in Dijkstra/. lazydijkstra only pushes a vertex when it is first reached
+#include <utility>
+struct dijkstra
+{
+	static constexpr const char* name = "dijkstra";
+	graph &g;
+	csrgraph symmetric; // g with both directions of each edge, if g does not store them
+	const csrgraph* adj; // Either g or symmetric
+	ll* dist;
+	opcounts ops;
+	dijkstra(graph &_g) : g(_g)
+	{
+		adj = &g;
+		if (!g.symmetric)
+		{
+			symmetric.symmetrise(g);
+			adj = &symmetric;
+		}
+		dist = new ll[g.v];
+	}
+	~dijkstra()
+	{
+		delete[] dist;
+	}
+	template<class K> bool supports()
+	{
+		return true;
+	}
+	template<class K> ll run(timer &t)
+	{
+		typedef typename K::template heap<heapvalue<std::pair<ll, int> > > heap; // Distance and vertex
+		typedef decltype(std::declval<heap&>().push(std::pair<ll, int>())) handle;
+		handle* nodes = new handle[g.v];
+		ops = opcounts();
+		t.start();
+		{
+			heap pq;
+			dist[0] = 0;
+			nodes[0] = pq.push(std::make_pair(0ll, 0));
+			for (int i = 1; i < g.v; i++)
+			{
+				dist[i] = 1e18;
+				nodes[i] = pq.push(std::make_pair(dist[i], i));
+			}
+			ops.push += g.v;
+			while (!pq.empty())
+			{
+				std::pair<ll, int> a = pq.top();
+				pq.pop();
+				ops.pop++;
+				for (ll j = adj->offsets[a.second]; j < adj->offsets[a.second+1]; j++)
+				{
+					int b = adj->targets[j];
+					if (a.first + adj->weights[j] < dist[b])
+					{
+						dist[b] = a.first + adj->weights[j];
+						pq.decreasekey(nodes[b], std::make_pair(dist[b], b));
+						ops.decreasekey++;
+					}
+				}
+			}
+		}
+		t.stop();
+		delete[] nodes;
+		return dist[g.v-1];
+	}
+};
+struct lazydijkstra : dijkstra // Decreasekey is only used on vertices already in the heap, so unreached vertices cost nothing
+{
+	static constexpr const char* name = "dijkstra-lazy";
+	lazydijkstra(graph &_g) : dijkstra(_g)
+	{
+	}
+	template<class K> ll run(timer &t)
+	{
+		typedef typename K::template heap<heapvalue<std::pair<ll, int> > > heap;
+		typedef decltype(std::declval<heap&>().push(std::pair<ll, int>())) handle;
+		handle* nodes = new handle[g.v];
+		ops = opcounts();
+		t.start();
+		{
+			heap pq;
+			for (int i = 1; i < g.v; i++) dist[i] = 1e18; // Not reached yet
+			dist[0] = 0;
+			nodes[0] = pq.push(std::make_pair(0ll, 0));
+			ops.push++;
+			while (!pq.empty())
+			{
+				std::pair<ll, int> a = pq.top();
+				pq.pop();
+				ops.pop++;
+				for (ll j = adj->offsets[a.second]; j < adj->offsets[a.second+1]; j++)
+				{
+					int b = adj->targets[j];
+					if (a.first + adj->weights[j] < dist[b])
+					{
+						bool reached = dist[b] != 1e18; // Popped vertices are never improved, so b is in the heap
+						dist[b] = a.first + adj->weights[j];
+						if (reached)
+						{
+							pq.decreasekey(nodes[b], std::make_pair(dist[b], b));
+							ops.decreasekey++;
+						}
+						else
+						{
+							nodes[b] = pq.push(std::make_pair(dist[b], b));
+							ops.push++;
+						}
+					}
+				}
+			}
+		}
+		t.stop();
+		delete[] nodes;
+		return dist[g.v-1];
+	}
+};
@@ -0,0 +1,210 @@
+// Edmonds' minimum branching algorithm on a directed graph, rooted at 0, the answer is the total weight of the branching
+// Each vertex (and supernode) has a heap of its incoming edges, heaps are merged when a cycle is contracted, so only mergeable heaps are run
+#include <queue>
+struct UFVal // Disjoint set union find data structure, used for supernodes
+{
+	int* rep; // Stores the highest node we know on the path from this node to its root
+	ll* val; // Stores sum of all values on the path from the node to its root, excluding the value of the root
+	ll* valatroot; // Stores the value at a root, or what value it had when it was a root
+	int n, upto;
+	UFVal(int _n) // Room for _n vertices and _n supernodes
+	{
+		n = _n;
+		rep = new int[2*n];
+		val = new ll[2*n];
+		valatroot = new ll[2*n];
+		reset();
+	}
+	~UFVal()
+	{
+		delete[] rep;
+		delete[] val;
+		delete[] valatroot;
+	}
+	void reset()
+	{
+		upto = n;
+		for (int i = 0; i < 2*n; i++)
+		{
+			rep[i] = i;
+			val[i] = valatroot[i] = 0;
+		}
+	}
+	int findrep(int a) // Finds the root of the tree that a is in. Updates the value of a as well
+	{
+		if (rep[a] == a) return a;
+		int b = rep[a];
+		rep[a] = findrep(b);
+		val[a] += val[b] + valatroot[a];
+		valatroot[a] = 0;
+		return rep[a];
+	}
+	bool connected(int a, int b) // Are a and b connected?
+	{
+		return findrep(a) == findrep(b);
+	}
+	void merge(int a, int b) // Joins the sets containing a and b
+	{
+		// Set a and b to their roots
+		a = findrep(a);
+		b = findrep(b);
+		rep[a] = b;
+	}
+	void addval(int a, ll val) // Adds val to the set containing a
+	{
+		a = findrep(a);
+		valatroot[a] += val;
+	}
+	ll findval(int a) // Returns the value of node a
+	{
+		int b = findrep(a);
+		return val[a] + valatroot[b];
+	}
+};
+struct edmonds
+{
+	static constexpr const char* name = "edmonds";
+	static inline UFVal* supernodes; // Stores all the compacted 'supernodes', read by the edges when they are compared
+	struct Edge // Stores a directed edge from u to v
+	{
+		int u, v;
+		ll weight;
+		ll val() const // Returns the corrected weight of this edge, i.e. weight - the value subtracted from all edges going into v
+		{
+			return weight - supernodes->findval(v);
+		}
+		bool operator<(const Edge &e) const
+		{
+			return val() < e.val();
+		}
+		bool operator>(const Edge &e) const
+		{
+			return val() > e.val();
+		}
+		bool operator<=(const Edge &e) const
+		{
+			return val() <= e.val();
+		}
+		bool operator>=(const Edge &e) const
+		{
+			return val() >= e.val();
+		}
+		friend std::pair<ll, int> _tracekey(const Edge &e) // Traces store the corrected weight at the time of the operation
+		{
+			return {e.val(), e.u};
+		}
+	};
+	graph &g;
+	UFVal uf;
+	int* trees; // Simpler union find, stores all the trees that have been constructed so far
+	Edge* par; // Stores the parent edge of a node, used to find cycles
+	opcounts ops;
+	edmonds(graph &_g) : g(_g), uf(_g.v)
+	{
+		trees = new int[g.v];
+		par = new Edge[2*g.v];
+	}
+	~edmonds()
+	{
+		delete[] trees;
+		delete[] par;
+	}
+	int findtree(int a)
+	{
+		while (trees[a] != a) a = trees[a] = trees[trees[a]]; // Path halving
+		return a;
+	}
+	template<class K> bool supports()
+	{
+		return K::mergeable;
+	}
+	template<class K> ll run(timer &t)
+	{
+		if constexpr (K::mergeable) solve<typename K::template heap<heapvalue<Edge> > >(t);
+		return ans;
+	}
+	ll ans;
+	template<class H> void solve(timer &t)
+	{
+		supernodes = &uf;
+		uf.reset();
+		for (int i = 0; i < g.v; i++) trees[i] = i;
+		ans = 0;
+		std::queue<int> roots; // Stores all the roots to be processed
+		H** incoming = new H*[2*g.v]; // Stores incoming edges in a heap
+		for (int i = 0; i < 2*g.v; i++) incoming[i] = new H();
+		ops = opcounts();
+		t.start();
+		for (int a = 0; a < g.v; a++) // Push onto heaps
+		{
+			for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
+			{
+				Edge e;
+				e.u = a;
+				e.v = g.targets[j];
+				e.weight = g.weights[j];
+				incoming[e.v]->push(e);
+			}
+		}
+		ops.push += g.m;
+		// Push all nodes onto the queue to be processed, except the root
+		for (int i = 1; i < g.v; i++)
+		{
+			roots.push(i);
+		}
+		// Run the algorithm
+		while (!roots.empty())
+		{
+			int a = roots.front();
+			roots.pop();
+			if (a != uf.findrep(a)) continue; // Ensure a is the root
+			// Find the minimum incoming edge
+			Edge e;
+			while (true)
+			{
+				assert(!incoming[a]->empty()); // If this fails, branching is not possible
+				e = incoming[a]->top();
+				incoming[a]->pop();
+				ops.pop++;
+				if (!uf.connected(e.u, e.v)) break; // We have found the edge!
+			}
+			ans += e.val(); // Add value to the answer
+			par[a] = e;
+			if (findtree(e.u) != findtree(e.v)) // They are in different trees
+			{
+				trees[findtree(e.u)] = findtree(e.v);
+			}
+			else // They are in the same tree, therefore a cycle was formed. Contract into a supernode
+			{
+				Edge mxedge = e; // Maximum edge on the cycle
+				int b = uf.findrep(e.u);
+				while (b != a) // Find the cycle, up
+				{
+					if (par[b].val() > mxedge.val()) mxedge = par[b]; // Update maximum edge if needed
+					b = uf.findrep(par[b].u);
+				}
+				// Remove mxedge from cost
+				ans -= mxedge.val();
+
+				int s = uf.upto++; // New supernode
+				// Go over the cycle again, merging the incoming edge lists
+				b = uf.findrep(e.u);
+				while (uf.findrep(b) != s)
+				{
+					// Subtract weight of par[b] - mxedge from the weight of all edges going into b
+					uf.addval(b, par[b].val() - mxedge.val());
+					// Merge the incoming edges of b into a
+					incoming[s]->merge(incoming[b]);
+					ops.merge++;
+					// Merge b and a
+					uf.merge(b, s);
+					b = uf.findrep(par[b].u);
+				}
+				roots.push(s);
+			}
+		}
+		t.stop();
+		for (int i = 0; i < 2*g.v; i++) delete incoming[i];
+		delete[] incoming;
+	}
+};
@@ -0,0 +1,600 @@
+// Differential fuzzer: drives a heap and a reference (std::multiset) with the same random operations and compares them
+// Usage: ./fuzz heap [cases] [-seed n] [-ops n]
+// Each case is a random program of up to -ops (default 1000) pushes, pops, decreasekeys (often to the same key), merges and erases
+// on one to four heaps, with few or many distinct keys, some cases far below zero. Case i is generated from seed+i (default seed 1), 1000 cases by default
+// After every operation the size and top of every heap are checked, and at the end the heaps are emptied and checked
+// Each case runs in a child process, so crashes and hangs (a few seconds) are caught as failures too
+// A failing case is shrunk by removing operations and simplifying the rest while it still fails, then printed step by step
+// Merge is only run on mergeable heaps, and erase on the heaps with erase(handle)
+// Some pushes give the heap a node allocated by the fuzzer, on the heaps that take one. At the end it checks that none was reused by the heap
+// The heaps for monotone keys (radix and bucket queues) only get keys at least the last key popped (or seen by top), and at most that plus
+// the C of the bucket queue
+// The heaps are fuzzed with fuzzvalue, then the others with long long values too, which take the SIMD path of the d-ary heaps
+// when compiled with -march=native. These hold the key in their high bits and the element in the low fuzzidbits bits
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <set>
+#include <vector>
+#include <random>
+#include <type_traits>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "heaps.cpp"
+#include "../Radix/radix.cpp"
+#include "../Bucket/bucket.cpp"
+typedef long long ll;
+struct fuzzvalue // A key and the element it belongs to. Only keys are compared, so elements with equal keys are ties the heap can pop in any order
+{
+	ll key;
+	int id;
+	fuzzvalue()
+	{
+	}
+	fuzzvalue(ll k, int i = -1) : key(k), id(i)
+	{
+	}
+	bool operator<(const fuzzvalue &b) const
+	{
+		return key < b.key;
+	}
+	bool operator>(const fuzzvalue &b) const
+	{
+		return key > b.key;
+	}
+	bool operator<=(const fuzzvalue &b) const
+	{
+		return key <= b.key;
+	}
+	bool operator>=(const fuzzvalue &b) const
+	{
+		return key >= b.key;
+	}
+};
+unsigned long long _radixkey(const fuzzvalue &a)
+{
+	return a.key;
+}
+unsigned long long _bucketkey(const fuzzvalue &a)
+{
+	return a.key;
+}
+const int fuzzidbits = 22;
+template<class V> struct fuzzvalues; // Makes values of type V from keys and elements, and takes them apart
+template<> struct fuzzvalues<fuzzvalue>
+{
+	static constexpr const char* name = "";
+	static fuzzvalue make(ll key, int id)
+	{
+		return fuzzvalue(key, id);
+	}
+	static ll key(const fuzzvalue &a)
+	{
+		return a.key;
+	}
+	static int id(const fuzzvalue &a)
+	{
+		return a.id;
+	}
+};
+template<> struct fuzzvalues<ll>
+{
+	static constexpr const char* name = " (long long)";
+	static ll make(ll key, int id)
+	{
+		return key * (1ll << fuzzidbits) + id;
+	}
+	static ll key(ll a)
+	{
+		return a >> fuzzidbits;
+	}
+	static int id(ll a)
+	{
+		return a & ((1 << fuzzidbits) - 1);
+	}
+};
+
+template<class H, class X, class = void> struct _fuzzerasable : std::false_type
+{
+};
+template<class H, class X> struct _fuzzerasable<H, X, std::void_t<decltype(std::declval<H&>().erase(std::declval<X>()))> > : std::true_type
+{
+};
+template<class H, class X, class V, class = void> struct _fuzzdecreasable : std::false_type
+{
+};
+template<class H, class X, class V> struct _fuzzdecreasable<H, X, V, std::void_t<decltype(std::declval<H&>().decreasekey(std::declval<X>(), std::declval<V>()))> > : std::true_type
+{
+};
+template<class H, class X, class V, class = void> struct _fuzznodepush : std::false_type // push(node) after setting node->val
+{
+};
+template<class H, class X, class V> struct _fuzznodepush<H, X, V, std::void_t<decltype(std::declval<H&>().push(std::declval<X>())), decltype(std::declval<X>()->val = std::declval<V>())> > : std::true_type
+{
+};
+template<class H, class X, class V, class = void> struct _fuzzitempush : std::false_type // push(item, val)
+{
+};
+template<class H, class X, class V> struct _fuzzitempush<H, X, V, std::void_t<decltype(std::declval<H&>().push(std::declval<X>(), std::declval<V>()))> > : std::true_type
+{
+};
+template<class K, class = void> struct _fuzzspread
+{
+	static constexpr ll value = 0;
+};
+template<class K> struct _fuzzspread<K, std::void_t<decltype(K::spread)> >
+{
+	static constexpr ll value = K::spread;
+};
+template<class K, class V = fuzzvalue> struct fuzzkind // The heap of kind K with values V the fuzzer runs, and what it can do
+{
+	typedef typename K::template heap<V> heap;
+	typedef decltype(std::declval<heap&>().push(V())) pushed;
+	typedef std::conditional_t<std::is_void<pushed>::value, int, pushed> handle; // int if push() returns nothing
+	static constexpr bool erasable = !std::is_void<pushed>::value && _fuzzerasable<heap, handle>::value;
+	static constexpr bool decreasable = !std::is_void<pushed>::value && _fuzzdecreasable<heap, handle, V>::value;
+	static constexpr bool nodepush = _fuzznodepush<heap, handle, V>::value;
+	static constexpr bool itempush = _fuzzitempush<heap, handle, V>::value;
+	static constexpr bool callerpush = nodepush || itempush; // Takes a node allocated by the fuzzer
+	static constexpr ll spread = _fuzzspread<K>::value; // For monotone keys, largest key pushed minus the last key popped, else 0
+	static heap* create()
+	{
+		if constexpr (std::is_constructible<heap, ll>::value && spread) return new heap(spread); // The C of a bucket queue
+		else return new heap();
+	}
+};
+
+// The heaps the fuzzer runs besides allheaps
+template<class T> using daryaligned16 = daryhandles<T, 16, true>;
+template<class T> struct _fuzzwide // T padded to 32 bytes
+{
+	T val;
+	char pad[32 - sizeof(T)];
+	bool operator<(const _fuzzwide &b) const
+	{
+		return val < b.val;
+	}
+};
+template<class T> struct darywide : daryhandles<_fuzzwide<T>, 4, true> // The aligned layout with 32 byte keys, two cache lines per group
+{
+	typedef daryhandles<_fuzzwide<T>, 4, true> base;
+	int push(T val)
+	{
+		return base::push({val, {}});
+	}
+	T top()
+	{
+		return base::top().val;
+	}
+	void decreasekey(int a, T val)
+	{
+		base::decreasekey(a, {val, {}});
+	}
+};
+template<class T> using bucketheap = bucket<T>;
+template<class T> using twolevelbucketheap = bucket<T, freelistallocator, true>;
+template<class T> using pairingnewheap = pairing<T, newallocator>; // The other allocators (see Allocator/allocator.cpp)
+template<class T> using fibonaccinewheap = fibonacci<T, newallocator>;
+template<class T> using fibonacciarenaheap = fibonacci<T, arenaallocator>;
+template<class T> using strictfibonaccinewheap = strictfibonacci<T, newallocator>;
+template<class T> using strictfibonacciarenaheap = strictfibonacci<T, arenaallocator>;
+#define FUZZKIND(kind, heapname, type, canmerge, C) \
+struct kind \
+{ \
+	template<class T> using heap = type<T>; \
+	static constexpr const char* name = heapname; \
+	static constexpr bool mergeable = canmerge; \
+	static constexpr ll spread = C; \
+};
+FUZZKIND(daryalignedkind, "dary-aligned", daryaligned16, false, 0)
+FUZZKIND(darywidekind, "dary-aligned-wide", darywide, false, 0)
+FUZZKIND(radixkind, "radix", radix, false, 1 << 30)
+FUZZKIND(radixdkkind, "radixdk", radixdk, false, 1 << 30)
+FUZZKIND(bucketkind, "bucket", bucketheap, false, 1000)
+FUZZKIND(twolevelbucketkind, "bucket-two-level", twolevelbucketheap, false, 100000)
+FUZZKIND(largebucketkind, "bucket-large", bucketheap, false, 1ll << 36) // Too many buckets for one level, so two levels of 2^18 and 2^19
+FUZZKIND(pairingnewkind, "pairing-new", pairingnewheap, true, 0)
+FUZZKIND(fibonaccinewkind, "fibonacci-new", fibonaccinewheap, true, 0)
+FUZZKIND(fibonacciarenakind, "fibonacci-arena", fibonacciarenaheap, true, 0)
+FUZZKIND(strictfibonaccinewkind, "strictfibonacci-new", strictfibonaccinewheap, true, 0)
+FUZZKIND(strictfibonacciarenakind, "strictfibonacci-arena", strictfibonacciarenaheap, true, 0)
+#undef FUZZKIND
+typedef allheaps::with<daryalignedkind, darywidekind, radixkind, radixdkkind, bucketkind, twolevelbucketkind, largebucketkind, pairingnewkind, fibonaccinewkind, fibonacciarenakind, strictfibonaccinewkind,
+	strictfibonacciarenakind> fuzzheaps;
+
+enum fuzzoperation { fuzzpush, fuzzpop, fuzzdecreasekey, fuzzmerge, fuzzerase };
+struct fuzzop // Every field is taken modulo what exists when it runs, so any subsequence of a program is a valid program
+{
+	int type;
+	int a; // Heap for push, pop and merge, element (among those in the heaps) for decreasekey and erase
+	int b; // Heap merged into heap a. For decreasekey, 1 to decrease to the same key. For push, 1 to push a node allocated by the fuzzer
+	ll key; // Pushed key is base + key, or for decreasekey, the new key is base + key % (current key - base + 1)
+	// For monotone keys, the pushed key is last + key % (spread + 1), the new key last + key % (current key - last + 1)
+};
+struct fuzzcase
+{
+	int heaps;
+	ll base; // Smallest key
+	std::vector<fuzzop> ops;
+};
+template<class K> fuzzcase generate(unsigned long long seed, int maxops)
+{
+	std::mt19937_64 rng(seed);
+	const ll keyranges[4] = {2, 16, 1000, 1 << 30};
+	fuzzcase c;
+	c.heaps = 1 + rng()%4;
+	c.base = rng()%4 || fuzzkind<K>::spread ? 0 : -(1ll << 40); // Far below any sentinel key a heap could use for erase
+	int callers = rng()%5; // Out of 4 pushes, how many use a node allocated by the fuzzer
+	ll keys = keyranges[rng()%4];
+	int weight[5]; // Of each operation, so some cases grow large heaps and others keep them almost empty
+	weight[fuzzpush] = 1 + rng()%8;
+	weight[fuzzpop] = 1 + rng()%8;
+	weight[fuzzdecreasekey] = fuzzkind<K>::decreasable ? rng()%9 : 0;
+	weight[fuzzmerge] = K::mergeable ? rng()%3 : 0;
+	weight[fuzzerase] = fuzzkind<K>::erasable ? rng()%3 : 0;
+	int total = 0;
+	for (int i = 0; i < 5; i++) total += weight[i];
+	c.ops.resize(1 + rng()%maxops);
+	for (fuzzop &op : c.ops)
+	{
+		int w = rng()%total;
+		op.type = 0;
+		while (w >= weight[op.type]) w -= weight[op.type++];
+		op.a = rng()%1000000;
+		if (op.type == fuzzdecreasekey) op.b = rng()%4 == 0;
+		else if (op.type == fuzzpush) op.b = (int)(rng()%4) < callers;
+		else op.b = rng()%4;
+		op.key = rng()%keys;
+	}
+	return c;
+}
+
+// Runs a case on heap kind K with values V and the reference. Returns false with a message if they differ
+// With verbose, prints each operation as it runs, resolved to heaps, elements and keys
+template<class K, class V> struct fuzzer
+{
+	typedef fuzzkind<K, V> kind;
+	typedef fuzzvalues<V> values;
+	typedef typename kind::heap heap;
+	typedef typename kind::handle handle;
+	std::vector<heap*> heaps;
+	std::vector<std::multiset<ll> > reference; // Keys in each heap
+	std::vector<ll> last; // For monotone keys, the last key popped or seen by top in each heap
+	std::vector<handle> handles; // Of each element pushed
+	std::vector<bool> callerowned; // Whether each element was pushed in a node allocated by the fuzzer
+	std::vector<ll> key; // Current key of each element
+	std::vector<int> heapof; // Heap each element is in, -1 once popped or erased
+	std::vector<int> elements; // Elements in the heaps, in no particular order
+	std::vector<int> at; // Index of each element in elements
+	char message[256];
+	bool fail(const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		vsnprintf(message, sizeof(message), format, args);
+		va_end(args);
+		return false;
+	}
+	void remove(int e) // Element e has left its heap
+	{
+		reference[heapof[e]].erase(reference[heapof[e]].find(key[e]));
+		heapof[e] = -1;
+		elements[at[e]] = elements.back();
+		at[elements.back()] = at[e];
+		elements.pop_back();
+	}
+	bool check(int i) // Compares heap i to the reference
+	{
+		heap* h = heaps[i];
+		std::multiset<ll> &r = reference[i];
+		if (h->size() != (int)r.size()) return fail("heap %d has size %d, expected %d", i, h->size(), (int)r.size());
+		if (h->empty() != r.empty()) return fail("heap %d is %s, expected %s", i, h->empty() ? "empty" : "not empty", r.empty() ? "empty" : "not empty");
+		if (r.empty()) return true;
+		V t = h->top();
+		ll k = values::key(t);
+		int id = values::id(t);
+		if (k != *r.begin()) return fail("heap %d has top key %lld, expected %lld", i, k, *r.begin());
+		if (id < 0 || id >= (int)key.size() || heapof[id] != i || key[id] != k) return fail("heap %d has top element %d with key %lld, which is not in it", i, id, k);
+		last[i] = k;
+		return true;
+	}
+	handle push(heap* h, const V &v, bool caller) // Pushes v, in a node allocated here if caller
+	{
+		if constexpr (kind::callerpush)
+		{
+			if (caller)
+			{
+				handle a = new std::remove_pointer_t<handle>();
+				if constexpr (kind::nodepush)
+				{
+					a->val = v;
+					h->push(a);
+				}
+				else h->push(a, v);
+				return a;
+			}
+		}
+		if constexpr (std::is_void<typename kind::pushed>::value)
+		{
+			h->push(v);
+			return handle();
+		}
+		else return h->push(v);
+	}
+	bool checknodes() // The nodes allocated by the fuzzer still hold their elements
+	{
+		for (int e = 0; e < (int)key.size(); e++)
+		{
+			if constexpr (kind::nodepush)
+			{
+				if (callerowned[e] && values::id(handles[e]->val) != e) return fail("the node of element %d, allocated by the fuzzer, was reused by the heap", e);
+			}
+		}
+		return true;
+	}
+	bool run(const fuzzcase &c, bool verbose)
+	{
+		for (int i = 0; i < c.heaps; i++)
+		{
+			heaps.push_back(kind::create());
+			reference.emplace_back();
+			last.push_back(0);
+		}
+		for (int step = 0; step < (int)c.ops.size(); step++)
+		{
+			const fuzzop &op = c.ops[step];
+			int h = op.a % c.heaps;
+			int e = elements.empty() ? -1 : elements[op.a % elements.size()];
+			if (op.type == fuzzpush)
+			{
+				int id = key.size();
+				ll k = kind::spread ? last[h] + op.key % (kind::spread + 1) : c.base + op.key;
+				bool caller = kind::callerpush && op.b;
+				if (verbose) printf("%d: push %lld onto heap %d, element %d%s\n", step, k, h, id, caller ? ", in a node allocated by the fuzzer" : "");
+				key.push_back(k);
+				heapof.push_back(h);
+				at.push_back(elements.size());
+				elements.push_back(id);
+				reference[h].insert(k);
+				callerowned.push_back(caller);
+				handles.push_back(push(heaps[h], values::make(k, id), caller));
+			}
+			else if (op.type == fuzzpop)
+			{
+				if (reference[h].empty()) continue;
+				if (verbose) printf("%d: pop heap %d\n", step, h);
+				V t = heaps[h]->top();
+				heaps[h]->pop();
+				remove(values::id(t)); // check() made sure top() is an element of heap h
+			}
+			else if (op.type == fuzzdecreasekey)
+			{
+				if (e < 0) continue;
+				ll lowest = kind::spread ? last[heapof[e]] : c.base;
+				ll k = op.b ? key[e] : lowest + op.key % (key[e] - lowest + 1);
+				if (verbose) printf("%d: decreasekey element %d in heap %d from %lld to %lld\n", step, e, heapof[e], key[e], k);
+				std::multiset<ll> &r = reference[heapof[e]];
+				r.erase(r.find(key[e]));
+				r.insert(k);
+				key[e] = k;
+				if constexpr (kind::decreasable) heaps[heapof[e]]->decreasekey(handles[e], values::make(k, e));
+			}
+			else if (op.type == fuzzmerge)
+			{
+				int b = op.b % c.heaps;
+				if (h == b) continue;
+				if (verbose) printf("%d: merge heap %d into heap %d\n", step, b, h);
+				if constexpr (K::mergeable) heaps[h]->merge(heaps[b]);
+				delete heaps[b]; // Its elements now belong to heap h
+				heaps[b] = kind::create();
+				reference[h].insert(reference[b].begin(), reference[b].end());
+				reference[b].clear();
+				for (int x : elements)
+				{
+					if (heapof[x] == b) heapof[x] = h;
+				}
+			}
+			else
+			{
+				if (e < 0) continue;
+				if (verbose) printf("%d: erase element %d with key %lld from heap %d\n", step, e, key[e], heapof[e]);
+				if constexpr (kind::erasable) heaps[heapof[e]]->erase(handles[e]);
+				remove(e);
+			}
+			if (verbose) fflush(stdout);
+			for (int i = 0; i < c.heaps; i++)
+			{
+				if (!check(i)) return false;
+			}
+		}
+		for (int i = 0; i < c.heaps; i++) // Empty the heaps
+		{
+			if (verbose) printf("end: pop all of heap %d\n", i);
+			while (!reference[i].empty())
+			{
+				V t = heaps[i]->top();
+				heaps[i]->pop();
+				remove(values::id(t));
+				if (!check(i)) return false;
+			}
+		}
+		if (!checknodes()) return false;
+		for (heap* h : heaps) delete h;
+		if constexpr (kind::callerpush)
+		{
+			for (int e = 0; e < (int)key.size(); e++)
+			{
+				if (callerowned[e]) delete handles[e];
+			}
+		}
+		return true;
+	}
+};
+
+// Runs a case in a child process. Returns false with the failure in message
+template<class K, class V> bool passes(const fuzzcase &c, bool verbose, char* message, int size)
+{
+	fflush(stdout);
+	int fd[2];
+	if (pipe(fd))
+	{
+		perror("pipe");
+		exit(2);
+	}
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		perror("fork");
+		exit(2);
+	}
+	if (!pid)
+	{
+		close(fd[0]);
+		alarm(2 + c.ops.size()/100000); // Far longer than any case takes
+		fuzzer<K, V>* f = new fuzzer<K, V>(); // Not freed if the case fails, the heaps may be broken
+		bool ok = f->run(c, verbose);
+		if (!ok && write(fd[1], f->message, strlen(f->message)) < 0) _exit(2);
+		fflush(stdout);
+		_exit(ok ? 0 : 1);
+	}
+	close(fd[1]);
+	int n = 0, r;
+	while (n < size-1 && (r = read(fd[0], message+n, size-1-n)) > 0) n += r;
+	message[n] = 0;
+	close(fd[0]);
+	int status;
+	waitpid(pid, &status, 0);
+	if (WIFSIGNALED(status))
+	{
+		if (WTERMSIG(status) == SIGALRM) snprintf(message, size, "timed out");
+		else snprintf(message, size, "crashed with signal %d (%s)", WTERMSIG(status), strsignal(WTERMSIG(status)));
+		return false;
+	}
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+template<class K, class V> fuzzcase shrink(fuzzcase c) // Smallest case found that still fails
+{
+	char message[256];
+	auto fails = [&](const fuzzcase &x)
+	{
+		return !passes<K, V>(x, false, message, sizeof(message));
+	};
+	bool progress = true;
+	while (progress)
+	{
+		progress = false;
+		for (int chunk = c.ops.size()/2; chunk >= 1; chunk /= 2) // Remove runs of operations, long ones first
+		{
+			for (int i = 0; i+chunk <= (int)c.ops.size(); )
+			{
+				fuzzcase x = c;
+				x.ops.erase(x.ops.begin()+i, x.ops.begin()+i+chunk);
+				if (fails(x))
+				{
+					c = x;
+					progress = true;
+				}
+				else i += chunk;
+			}
+		}
+		for (int h = 1; h < c.heaps; h++) // Fewer heaps
+		{
+			fuzzcase x = c;
+			x.heaps = h;
+			if (fails(x))
+			{
+				c = x;
+				progress = true;
+				break;
+			}
+		}
+		for (int i = 0; i < (int)c.ops.size(); i++) // Simpler operations: smaller keys and the first heaps and elements
+		{
+			for (int s = 0; s < 4; s++) // Each from the operation as simplified so far
+			{
+				fuzzop op = c.ops[i];
+				if (s == 0) op.key = 0;
+				else if (s == 1) op.key /= 2;
+				else if (s == 2) op.a = 0;
+				else op.b = 0;
+				if (op.key == c.ops[i].key && op.a == c.ops[i].a && op.b == c.ops[i].b) continue;
+				fuzzcase x = c;
+				x.ops[i] = op;
+				if (fails(x))
+				{
+					c = x;
+					progress = true;
+				}
+			}
+		}
+	}
+	return c;
+}
+
+struct options
+{
+	int cases = 1000;
+	ll seed = 1;
+	int ops = 1000;
+};
+struct fuzzrunner
+{
+	options &opt;
+	bool failed = false;
+	fuzzrunner(options &o) : opt(o)
+	{
+	}
+	template<class K> void run()
+	{
+		run<K, fuzzvalue>();
+		if constexpr (!fuzzkind<K>::spread) run<K, ll>(); // The monotone heaps take the key of a long long value to be all of it
+	}
+	template<class K, class V> void run()
+	{
+		char message[256];
+		const char* v = fuzzvalues<V>::name;
+		for (int i = 0; i < opt.cases; i++)
+		{
+			fuzzcase c = generate<K>(opt.seed+i, opt.ops);
+			if (passes<K, V>(c, false, message, sizeof(message))) continue;
+			printf("%s%s: case %lld (-seed %lld) failed after %d operations on %d heaps: %s\n", K::name, v, opt.seed+i, opt.seed+i, (int)c.ops.size(), c.heaps, message);
+			c = shrink<K, V>(c);
+			printf("%s%s: shrunk to %d operations on %d heaps:\n", K::name, v, (int)c.ops.size(), c.heaps);
+			passes<K, V>(c, true, message, sizeof(message));
+			printf("%s%s: %s\n", K::name, v, message);
+			failed = true;
+			return;
+		}
+		printf("%s%s: %d cases passed\n", K::name, v, opt.cases);
+		fflush(stdout);
+	}
+};
+int usage(const char* name)
+{
+	fprintf(stderr, "Usage: %s heap [cases] [-seed n] [-ops n]\n", name);
+	fprintf(stderr, "The heaps are: all");
+	fuzzheaps::printnames(stderr);
+	return 1;
+}
+int main(int argc, char* argv[])
+{
+	if (argc < 2) return usage(argv[0]);
+	options opt;
+	for (int i = 2; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-seed") && i+1 < argc) opt.seed = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-ops") && i+1 < argc) opt.ops = atoi(argv[++i]);
+		else if (i == 2 && argv[i][0] != '-') opt.cases = atoi(argv[i]);
+		else return usage(argv[0]);
+	}
+	if (opt.ops < 1) opt.ops = 1;
+	if (opt.ops > 1 << fuzzidbits) opt.ops = 1 << fuzzidbits; // Elements must fit in the low bits of long long values
+	fuzzrunner f(opt);
+	if (!fuzzheaps::forheaps(argv[1], f))
+	{
+		fprintf(stderr, "Unknown heap %s\n", argv[1]);
+		return usage(argv[0]);
+	}
+	return f.failed;
+}
@@ -0,0 +1,12 @@
+// Graph read from stdin, either in the text format produced by the generators ("v e" then e lines of "a b weight"),
+// or in the binary CSR format written by tocsr, which is mapped instead of read (see ../Graph/csr.cpp)
+// A text graph is stored directed, each edge out of its first vertex. The algorithms use the edges as they need
+#include <cstdio>
+#include "../Graph/csr.cpp"
+struct graph : csrgraph
+{
+	bool read(FILE* in) // Returns false if the input is malformed
+	{
+		return csrgraph::read(in, false);
+	}
+};
@@ -0,0 +1,91 @@
+// The heaps the benchmark can run, included from their library directories
+// Each heap is described by a kind: its name on the command line, its type for a given value type, and whether it can merge
+// All kinds take handles from push() and pass them back to decreasekey()
+// The algorithms store heapvalue<T> in the heaps, which counts its comparisons when compiled with -DHEAPS_COUNTERS
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include "../D-ary/d-ary.cpp"
+#include "../Pairing/pairing.cpp"
+#include "../Fibonacci/fibonacci.cpp"
+#include "../Binomial/binomial.cpp"
+#include "../Hollow/hollow.cpp"
+#include "../Quake/quake.cpp"
+namespace smoothforest // The two smooth heaps share their names
+{
+#include "../Smooth/forest.cpp"
+}
+namespace smoothonetree
+{
+#include "../Smooth/one-tree.cpp"
+}
+#include "../Violation/violation.cpp"
+#include "../Rank Pairing/rankpairing.cpp"
+#include "../Strict Fibonacci/strictfibonacci.cpp"
+
+template<class T, int D, bool Aligned = false> struct daryhandles : dary<T, D, Aligned> // decreasekey() takes the index returned by push(), like the handles of the other heaps
+{
+	void decreasekey(int a, T val)
+	{
+		dary<T, D, Aligned>::decreasekey(this->at[a], val);
+	}
+};
+template<class T> using binaryheap = daryhandles<T, 2>;
+template<class T> using dary16 = daryhandles<T, 16>; // 16 children per node, as in the Dijkstra and Stoer-Wagner drivers
+template<class T> using pairingmultipassheap = pairing<T, freelistallocator, pairingmultipass>;
+template<class T> using pairingarenaheap = pairing<T, arenaallocator>; // Never reuses a popped node, against the default free list
+template<class T> using smoothforestheap = smoothforest::smooth<T>;
+template<class T> using smoothonetreeheap = smoothonetree::smooth<T>;
+#ifdef HEAPS_COUNTERS
+template<class T> using heapvalue = counted<T>;
+#else
+template<class T> using heapvalue = T;
+#endif
+
+#define HEAPKIND(kind, heapname, type, canmerge) \
+struct kind \
+{ \
+	template<class T> using heap = type<T>; \
+	static constexpr const char* name = heapname; \
+	static constexpr bool mergeable = canmerge; \
+};
+HEAPKIND(binarykind, "binary", binaryheap, false)
+HEAPKIND(darykind, "dary", dary16, false)
+HEAPKIND(pairingkind, "pairing", pairing, true)
+HEAPKIND(pairingmultipasskind, "pairing-multipass", pairingmultipassheap, true)
+HEAPKIND(pairingarenakind, "pairing-arena", pairingarenaheap, true)
+HEAPKIND(fibonaccikind, "fibonacci", fibonacci, true)
+HEAPKIND(binomialkind, "binomial", binomial, true)
+HEAPKIND(hollowkind, "hollow", hollow, true)
+HEAPKIND(quakekind, "quake", quake, true)
+HEAPKIND(smoothkind, "smooth", smoothforestheap, true)
+HEAPKIND(smoothonetreekind, "smooth-one-tree", smoothonetreeheap, true)
+HEAPKIND(violationkind, "violation", violation, true)
+HEAPKIND(rankpairingkind, "rankpairing", rankpairing, true)
+HEAPKIND(strictfibonaccikind, "strictfibonacci", strictfibonacci, true)
+#undef HEAPKIND
+
+template<class K, class F> bool _forheap(const char* name, F &f)
+{
+	if (strcmp(name, "all") && strcmp(name, K::name)) return false;
+	f.template run<K>();
+	return true;
+}
+template<class... K> struct heaplist
+{
+	template<class F> static bool forheaps(const char* name, F &f) // Calls f.run<kind>() for the heap called name, or for every heap if name is "all"
+	{
+		bool found = false;
+		((found |= _forheap<K>(name, f)), ...); // In order
+		return found;
+	}
+	template<class... X> using with = heaplist<K..., X...>; // This list followed by more kinds
+	static void printnames(FILE* f)
+	{
+		((fprintf(f, " %s", K::name)), ...);
+		fprintf(f, "\n");
+	}
+};
+typedef heaplist<binarykind, darykind, pairingkind, pairingmultipasskind, pairingarenakind, fibonaccikind, binomialkind, hollowkind, quakekind, smoothkind, smoothonetreekind, violationkind, rankpairingkind, strictfibonaccikind> allheaps;
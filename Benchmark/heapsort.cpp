@@ -0,0 +1,274 @@
+// Heapsort with every heap: pushes n int keys, then pops them all, writing them out in order
+// Usage: ./heapsort n distribution heap [runs] [-format text|csv|json] [-seed n] [-perf]
+// distribution is sorted, reverse, random, duplicates (100 distinct keys) or all
+// heap is the name of a heap, std::sort, std::priority_queue or all. Each is run the given number of times (default 5)
+// text prints the median push, pop and total times in nanoseconds, csv and json print records as in benchmark.cpp,
+// with algorithm heapsort-<distribution>-push, -pop and heapsort-<distribution> (the total), v = n and e = 0
+// perf reads hardware performance counters around the pushes and the pops, as in benchmark.cpp
+// The output of every run is checked, and its answer is 1 if it was sorted, 0 if not
+// With -DHEAPS_COUNTERS, the push and pop records carry the counters of their phase, and the total record their sum
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <random>
+#include <type_traits>
+#include "heaps.cpp"
+#include "timer.cpp"
+#include "record.cpp"
+template<class T> struct stdpq // std::priority_queue as a minimum heap
+{
+	std::priority_queue<T, std::vector<T>, std::greater<T> > pq;
+	void push(T val)
+	{
+		pq.push(val);
+	}
+	T top()
+	{
+		return pq.top();
+	}
+	void pop()
+	{
+		pq.pop();
+	}
+};
+template<class T> using dary4 = daryhandles<T, 4>;
+template<class T> using dary8 = daryhandles<T, 8>;
+struct dary4kind
+{
+	template<class T> using heap = dary4<T>;
+	static constexpr const char* name = "4-ary";
+};
+struct dary8kind
+{
+	template<class T> using heap = dary8<T>;
+	static constexpr const char* name = "8-ary";
+};
+struct stdpqkind
+{
+	template<class T> using heap = stdpq<T>;
+	static constexpr const char* name = "std::priority_queue";
+};
+struct stdsortkind // Not a heap, sorted in place
+{
+	static constexpr const char* name = "std::sort";
+};
+typedef allheaps::with<dary4kind, dary8kind, stdpqkind, stdsortkind> sortheaps;
+
+const char* distributions[] = {"sorted", "reverse", "random", "duplicates"};
+void generate(int* keys, int n, int distribution, unsigned long long seed)
+{
+	std::mt19937_64 rng(seed);
+	for (int i = 0; i < n; i++)
+	{
+		if (distribution == 0) keys[i] = i;
+		else if (distribution == 1) keys[i] = n-1-i;
+		else if (distribution == 2) keys[i] = rng() % 2000000000;
+		else keys[i] = rng() % 100;
+	}
+}
+struct options
+{
+	int runs = 5;
+	recordformat format = formattext;
+	ll seed = 1;
+	perfcounters* perf = nullptr; // Set by -perf
+};
+struct heapsort
+{
+	int* keys; // Input
+	int* out; // Output
+	int n, distribution;
+	ll sum; // Of the keys, to check the output
+	heapcounters counters[2]; // Of the pushes and the pops of the last run
+	options &opt;
+	heapsort(int _n, options &o) : n(_n), opt(o)
+	{
+		keys = new int[n];
+		out = new int[n];
+	}
+	~heapsort()
+	{
+		delete[] keys;
+		delete[] out;
+	}
+	void setdistribution(int d)
+	{
+		distribution = d;
+		generate(keys, n, d, opt.seed);
+		sum = 0;
+		for (int i = 0; i < n; i++) sum += keys[i];
+	}
+	bool sorted() // Whether out holds the keys in order
+	{
+		ll s = 0;
+		for (int i = 0; i < n; i++)
+		{
+			if (i && out[i] < out[i-1]) return false;
+			s += out[i];
+		}
+		return s == sum;
+	}
+	template<class K> void sort(timer &push, timer &pop) // The std::sort baseline has no pushes, its time is all pop
+	{
+		counters[0] = counters[1] = heapcounters();
+		if constexpr (std::is_same<K, stdsortkind>::value)
+		{
+			push.start();
+			push.stop();
+			pop.start();
+			for (int i = 0; i < n; i++) out[i] = keys[i];
+			std::sort(out, out+n);
+			pop.stop();
+		}
+		else
+		{
+			typename K::template heap<heapvalue<int> > pq;
+#ifdef HEAPS_COUNTERS
+			_heapcounters = heapcounters();
+#endif
+			push.start();
+			for (int i = 0; i < n; i++) pq.push(keys[i]);
+			push.stop();
+#ifdef HEAPS_COUNTERS
+			counters[0] = _heapcounters;
+			_heapcounters = heapcounters();
+#endif
+			pop.start();
+			for (int i = 0; i < n; i++)
+			{
+				out[i] = pq.top();
+				pq.pop();
+			}
+			pop.stop();
+#ifdef HEAPS_COUNTERS
+			counters[1] = _heapcounters;
+#endif
+		}
+	}
+	template<class K> void run()
+	{
+		char name[3][64];
+		snprintf(name[0], 64, "heapsort-%s-push", distributions[distribution]);
+		snprintf(name[1], 64, "heapsort-%s-pop", distributions[distribution]);
+		snprintf(name[2], 64, "heapsort-%s", distributions[distribution]);
+		record* records = new record[3*opt.runs];
+		ll* times[3];
+		for (int j = 0; j < 3; j++) times[j] = new ll[opt.runs];
+		resetpeakrss();
+		for (int r = 0; r < opt.runs; r++)
+		{
+			timer push, pop;
+			push.perf = pop.perf = opt.perf;
+			sort<K>(push, pop);
+			bool ok = sorted();
+			if (!ok) fprintf(stderr, "%s %s: output is not sorted\n", name[2], K::name);
+			times[0][r] = push.elapsed;
+			times[1][r] = pop.elapsed;
+			times[2][r] = push.elapsed + pop.elapsed;
+			for (int j = 0; j < 3; j++)
+			{
+				record &rec = records[3*r+j];
+				rec.algorithm = name[j];
+				rec.heap = K::name;
+				rec.v = n;
+				rec.e = 0;
+				rec.seed = opt.seed;
+				rec.run = r;
+				rec.answer = ok;
+				rec.time = times[j][r];
+				if (j != 1 && !std::is_same<K, stdsortkind>::value) rec.ops.push = n;
+				if (j != 0 && !std::is_same<K, stdsortkind>::value) rec.ops.pop = n;
+				if (j != 1) rec.counters += counters[0];
+				if (j != 0) rec.counters += counters[1];
+				for (int i = 0; i < perfevents; i++)
+				{
+					if (j == 2) rec.events[i] = push.events[i] < 0 || pop.events[i] < 0 ? -1 : push.events[i] + pop.events[i];
+					else rec.events[i] = (j ? pop : push).events[i];
+				}
+			}
+		}
+		ll rss = peakrss();
+		for (int i = 0; i < 3*opt.runs; i++)
+		{
+			records[i].peakrss = rss;
+			printrecord(opt.format, records[i], opt.perf);
+		}
+		if (opt.format == formattext)
+		{
+			runstats push(times[0], opt.runs), pop(times[1], opt.runs), total(times[2], opt.runs);
+			printf("%-12s %-20s %12d %5d %14lld %14lld %14lld %12lld\n", distributions[distribution], K::name, n, opt.runs, push.median, pop.median, total.median, rss);
+			if (opt.perf)
+			{
+				record* totals = new record[opt.runs];
+				for (int r = 0; r < opt.runs; r++) totals[r] = records[3*r+2];
+				printperf(totals, opt.runs);
+				delete[] totals;
+			}
+#ifdef HEAPS_COUNTERS
+			printcounters(records[2].counters);
+#endif
+		}
+		fflush(stdout);
+		delete[] records;
+		for (int j = 0; j < 3; j++) delete[] times[j];
+	}
+};
+int usage(const char* name)
+{
+	fprintf(stderr, "Usage: %s n distribution heap [runs] [-format text|csv|json] [-seed n] [-perf]\n", name);
+	fprintf(stderr, "The distributions are: all sorted reverse random duplicates\n");
+	fprintf(stderr, "The heaps are: all");
+	sortheaps::printnames(stderr);
+	return 1;
+}
+int main(int argc, char* argv[])
+{
+	if (argc < 4) return usage(argv[0]);
+	options opt;
+	for (int i = 4; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-format") && i+1 < argc)
+		{
+			i++;
+			if (!strcmp(argv[i], "text")) opt.format = formattext;
+			else if (!strcmp(argv[i], "csv")) opt.format = formatcsv;
+			else if (!strcmp(argv[i], "json")) opt.format = formatjson;
+			else return usage(argv[0]);
+		}
+		else if (!strcmp(argv[i], "-seed") && i+1 < argc) opt.seed = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-perf"))
+		{
+			if (!opt.perf) opt.perf = new perfcounters();
+		}
+		else if (i == 4 && argv[i][0] != '-') opt.runs = atoi(argv[i]);
+		else return usage(argv[0]);
+	}
+	if (opt.runs < 1) opt.runs = 1;
+	if (opt.perf && !opt.perf->available()) fprintf(stderr, "Hardware performance counters are not available (see /proc/sys/kernel/perf_event_paranoid), they are reported as -1\n");
+	int n = atoi(argv[1]);
+	if (n < 1) return usage(argv[0]);
+	int first = 0, last = 3; // Distributions to run
+	if (strcmp(argv[2], "all"))
+	{
+		first = 0;
+		while (first < 4 && strcmp(argv[2], distributions[first])) first++;
+		if (first == 4) return usage(argv[0]);
+		last = first;
+	}
+	heapsort h(n, opt);
+	if (opt.format == formattext) printf("%-12s %-20s %12s %5s %14s %14s %14s %12s\n", "distribution", "heap", "n", "runs", "push(ns)", "pop(ns)", "total(ns)", "peakrss(kB)");
+	else printheader(opt.format, opt.perf);
+	for (int d = first; d <= last; d++)
+	{
+		h.setdistribution(d);
+		if (!sortheaps::forheaps(argv[3], h))
+		{
+			fprintf(stderr, "Unknown heap %s\n", argv[3]);
+			return usage(argv[0]);
+		}
+	}
+	return 0;
+}
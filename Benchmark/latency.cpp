@@ -0,0 +1,183 @@
+// Latency of individual heap operations, for comparing the worst-case heaps with the amortised ones
+// timedkind<K> runs heap K with every push, pop, decreasekey and merge timestamped, and adds the time taken to _latency
+// Timestamps are read with rdtsc on x86 (converted to nanoseconds with a calibration against steady_clock), steady_clock elsewhere
+// Each operation then includes the cost of reading the clock, latencyclock::overhead estimates it
+// Latencies are kept in HDR-style histograms: exact below 128 ticks, then 64 buckets per power of two, so values are within 1/64
+// Uses recordformat from record.cpp
+#include <chrono>
+#include <utility>
+#include <cstring>
+#include "../Counters/counters.cpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LATENCY_RDTSC
+#endif
+typedef long long ll;
+struct latencyclock
+{
+	static inline double nspertick = 1;
+	static ll ticks()
+	{
+#ifdef LATENCY_RDTSC
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+	static void calibrate() // Measures the tick rate over 20ms
+	{
+#ifdef LATENCY_RDTSC
+		auto begin = std::chrono::steady_clock::now();
+		ll t = ticks();
+		ll ns;
+		do ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+		while (ns < 20000000);
+		nspertick = (double)ns/(ticks() - t);
+#endif
+	}
+	static double overhead() // Nanoseconds between two consecutive timestamps, the least an operation can measure
+	{
+		ll best = 1ll << 62;
+		for (int i = 0; i < 1000; i++)
+		{
+			ll a = ticks();
+			ll b = ticks();
+			if (b - a < best) best = b - a;
+		}
+		return best*nspertick;
+	}
+};
+struct latencyhistogram
+{
+	static constexpr int EXACT = 128, HALF = EXACT/2; // Values below EXACT have their own bucket, then HALF buckets per power of two
+	static constexpr int BUCKETS = EXACT + 57*HALF;
+	ll count[BUCKETS];
+	ll n, sum, mx;
+	latencyhistogram()
+	{
+		clear();
+	}
+	void clear()
+	{
+		memset(count, 0, sizeof(count));
+		n = sum = mx = 0;
+	}
+	static int bucket(ll v)
+	{
+		if (v < EXACT) return v < 0 ? 0 : v;
+		int shift = 64 - __builtin_clzll(v) - 7; // v >> shift is in [HALF, EXACT)
+		return EXACT + (shift-1)*HALF + (int)(v >> shift) - HALF;
+	}
+	static ll highest(int b) // Largest value in bucket b
+	{
+		if (b < EXACT) return b;
+		int shift = (b - EXACT)/HALF + 1;
+		ll top = (b - EXACT)%HALF + HALF;
+		return ((top + 1) << shift) - 1;
+	}
+	void add(ll v)
+	{
+		count[bucket(v)]++;
+		n++;
+		sum += v;
+		if (v > mx) mx = v;
+	}
+	ll percentile(double p) // The value that p percent of the values are at most, the upper end of its bucket
+	{
+		if (!n) return 0;
+		ll rank = (ll)(p/100*n); // Rounded up
+		if (rank < p/100*n || rank < 1) rank++;
+		if (rank >= n) return mx;
+		ll seen = 0;
+		for (int b = 0; b < BUCKETS; b++)
+		{
+			seen += count[b];
+			if (seen >= rank) return highest(b) < mx ? highest(b) : mx;
+		}
+		return mx;
+	}
+};
+inline latencyhistogram _latency[4]; // One for each heapoperation, in ticks
+
+struct _latencyscope // Adds the time until it goes out of scope, i.e. after the operation returns
+{
+	int op;
+	ll begin;
+	_latencyscope(int o) : op(o), begin(latencyclock::ticks())
+	{
+	}
+	~_latencyscope()
+	{
+		_latency[op].add(latencyclock::ticks() - begin);
+	}
+};
+template<class H> struct timedheap : H
+{
+	template<class... A> decltype(auto) push(A&&... a)
+	{
+		_latencyscope s(heappush);
+		return H::push(std::forward<A>(a)...);
+	}
+	void pop()
+	{
+		_latencyscope s(heappop);
+		H::pop();
+	}
+	template<class... A> void decreasekey(A&&... a)
+	{
+		_latencyscope s(heapdecreasekey);
+		H::decreasekey(std::forward<A>(a)...);
+	}
+	void merge(timedheap* a)
+	{
+		_latencyscope s(heapmerge);
+		H::merge(a);
+	}
+};
+template<class K> struct timedkind // Kind K with its operations timed
+{
+	template<class T> using heap = timedheap<typename K::template heap<T> >;
+	static constexpr const char* name = K::name;
+	static constexpr bool mergeable = K::mergeable;
+};
+
+// Reports, one line per kind of operation that was performed
+const char* _latencyops[4] = {"push", "pop", "decreasekey", "merge"};
+const double _latencypercentiles[5] = {50, 90, 99, 99.9, 99.99};
+void printlatencyheader(recordformat f)
+{
+	if (f == formattext)
+	{
+		printf("%-14s %-16s %-12s %12s %10s %10s %10s %10s %10s %10s %12s\n", "algorithm", "heap", "operation", "count", "mean(ns)",
+			"p50(ns)", "p90(ns)", "p99(ns)", "p99.9(ns)", "p99.99(ns)", "max(ns)");
+	}
+	else if (f == formatcsv) printf("algorithm,heap,v,e,seed,operation,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,p9999_ns,max_ns\n");
+}
+void printlatency(recordformat f, const char* algorithm, const char* heap, int v, int e, ll seed)
+{
+	for (int op = 0; op < 4; op++)
+	{
+		latencyhistogram &h = _latency[op];
+		if (!h.n) continue;
+		double mean = (double)h.sum/h.n*latencyclock::nspertick;
+		ll p[5];
+		for (int i = 0; i < 5; i++) p[i] = (ll)(h.percentile(_latencypercentiles[i])*latencyclock::nspertick + 0.5);
+		ll mx = (ll)(h.mx*latencyclock::nspertick + 0.5);
+		if (f == formattext)
+		{
+			printf("%-14s %-16s %-12s %12lld %10.1f %10lld %10lld %10lld %10lld %10lld %12lld\n", algorithm, heap, _latencyops[op], h.n, mean,
+				p[0], p[1], p[2], p[3], p[4], mx);
+		}
+		else if (f == formatcsv)
+		{
+			printf("%s,%s,%d,%d,%lld,%s,%lld,%.1f,%lld,%lld,%lld,%lld,%lld,%lld\n", algorithm, heap, v, e, seed, _latencyops[op], h.n, mean,
+				p[0], p[1], p[2], p[3], p[4], mx);
+		}
+		else
+		{
+			printf("{\"algorithm\":\"%s\",\"heap\":\"%s\",\"v\":%d,\"e\":%d,\"seed\":%lld,\"operation\":\"%s\",\"count\":%lld,\"mean_ns\":%.1f,"
+				"\"p50_ns\":%lld,\"p90_ns\":%lld,\"p99_ns\":%lld,\"p999_ns\":%lld,\"p9999_ns\":%lld,\"max_ns\":%lld}\n", algorithm, heap, v, e, seed,
+				_latencyops[op], h.n, mean, p[0], p[1], p[2], p[3], p[4], mx);
+		}
+	}
+}
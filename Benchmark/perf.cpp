@@ -0,0 +1,85 @@
+// Hardware performance counters from Linux perf_event_open, read around the timed region of a run
+// Each event is opened on its own, so events the CPU or kernel does not support are skipped and the others still count
+// Only user space is counted, which perf_event_paranoid allows up to level 2
+// If the kernel multiplexes the events, the counts are scaled by the fraction of the time each one was counted
+#ifndef BENCHMARK_PERF_H
+#define BENCHMARK_PERF_H
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+typedef long long ll;
+enum perfevent { perfcycles, perfinstructions, perfl1dmisses, perfllcmisses, perfbranchmisses, perfdtlbmisses, perfevents };
+const char* _perfnames[perfevents] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"};
+struct perfcounters
+{
+	int fd[perfevents];
+	ll values[perfevents]; // Counts of the last region, -1 for events that could not be opened
+	perfcounters()
+	{
+		const unsigned int type[perfevents] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+		const unsigned long long config[perfevents] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+			PERF_COUNT_HW_CACHE_MISSES, // Last level cache
+			PERF_COUNT_HW_BRANCH_MISSES,
+			PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+		for (int i = 0; i < perfevents; i++)
+		{
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = type[i];
+			attr.config = config[i];
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0); // This process, any CPU
+			values[i] = -1;
+		}
+	}
+	perfcounters(const perfcounters&) = delete; // Owns its file descriptors
+	perfcounters& operator=(const perfcounters&) = delete;
+	~perfcounters()
+	{
+		for (int i = 0; i < perfevents; i++)
+		{
+			if (fd[i] >= 0) close(fd[i]);
+		}
+	}
+	bool available() // Whether any event could be opened
+	{
+		for (int i = 0; i < perfevents; i++)
+		{
+			if (fd[i] >= 0) return true;
+		}
+		return false;
+	}
+	void start()
+	{
+		for (int i = 0; i < perfevents; i++)
+		{
+			if (fd[i] < 0) continue;
+			ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+	void stop()
+	{
+		for (int i = 0; i < perfevents; i++)
+		{
+			if (fd[i] >= 0) ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+		}
+		for (int i = 0; i < perfevents; i++)
+		{
+			values[i] = -1;
+			ll v[3]; // Count, time enabled, time running
+			if (fd[i] < 0 || read(fd[i], v, sizeof(v)) != sizeof(v)) continue;
+			if (v[2] == 0) values[i] = 0; // Never scheduled
+			else values[i] = v[2] < v[1] ? (ll)((double)v[0]*v[1]/v[2]) : v[0];
+		}
+	}
+};
+#endif
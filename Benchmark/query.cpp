@@ -0,0 +1,113 @@
+// Point to point shortest path queries on an undirected graph, the answer is the sum of the distances (1e18 if t is not reachable)
+// The queries are random pairs of vertices generated from the seed, or the single pair 0 to v-1 that the other Dijkstra algorithms answer
+// dijkstraquery answers queries one after another on the same graph: the search stops once t is settled, and only the vertices a
+// query touched are reset, by stamping each vertex with the query that last set its distance, so a query costs its search space
+#include <random>
+#include <vector>
+#include <utility>
+struct queryset
+{
+	const csrgraph* adj; // Both directions of each edge
+	csrgraph symmetric; // If the graph does not store them
+	std::vector<std::pair<int, int> > pairs;
+	queryset(graph &g, int queries, ll seed) // 0 queries is the single query from 0 to v-1
+	{
+		adj = &g;
+		if (!g.symmetric)
+		{
+			symmetric.symmetrise(g);
+			adj = &symmetric;
+		}
+		if (!queries) pairs.emplace_back(0, g.v-1);
+		std::mt19937_64 rng(seed);
+		for (int i = 0; i < queries; i++) pairs.emplace_back(rng() % g.v, rng() % g.v);
+	}
+};
+template<class H> struct dijkstraquery // H is a heap of (distance, vertex)
+{
+	typedef decltype(std::declval<H&>().push(std::pair<ll, int>())) handle;
+	const csrgraph &g;
+	ll* dist;
+	handle* nodes;
+	unsigned* stamp; // dist and nodes of a vertex are only set if its stamp is now
+	unsigned now = 0;
+	opcounts ops;
+	dijkstraquery(const csrgraph &_g) : g(_g)
+	{
+		dist = new ll[g.v];
+		nodes = new handle[g.v];
+		stamp = new unsigned[g.v]();
+	}
+	~dijkstraquery()
+	{
+		delete[] dist;
+		delete[] nodes;
+		delete[] stamp;
+	}
+	void next() // Starts a new query, which forgets every distance
+	{
+		if (!++now) // Wrapped around, an old stamp could be mistaken for the new one
+		{
+			for (int i = 0; i < g.v; i++) stamp[i] = 0;
+			now = 1;
+		}
+	}
+	bool reached(int a)
+	{
+		return stamp[a] == now;
+	}
+	void relax(H &pq, int b, ll d) // Reaches b at distance d, if that is shorter
+	{
+		if (!reached(b))
+		{
+			dist[b] = d;
+			stamp[b] = now;
+			nodes[b] = pq.push(std::make_pair(d, b));
+			ops.push++;
+		}
+		else if (d < dist[b]) // Settled vertices are never improved, so b is in the heap
+		{
+			dist[b] = d;
+			pq.decreasekey(nodes[b], std::make_pair(d, b));
+			ops.decreasekey++;
+		}
+	}
+	ll query(int s, int t) // Distance from s to t
+	{
+		next();
+		H pq; // Only holds the frontier, so it is as cheap to make as to empty
+		relax(pq, s, 0);
+		while (!pq.empty())
+		{
+			std::pair<ll, int> a = pq.top();
+			if (a.second == t) return a.first; // Settled
+			pq.pop();
+			ops.pop++;
+			for (ll j = g.offsets[a.second]; j < g.offsets[a.second+1]; j++) relax(pq, g.targets[j], a.first + g.weights[j]);
+		}
+		return 1e18;
+	}
+};
+struct pointqueries
+{
+	static constexpr const char* name = "dijkstra-query";
+	queryset &q;
+	opcounts ops;
+	pointqueries(queryset &_q) : q(_q)
+	{
+	}
+	template<class K> bool supports()
+	{
+		return true;
+	}
+	template<class K> ll run(timer &t)
+	{
+		dijkstraquery<typename K::template heap<heapvalue<std::pair<ll, int> > > > engine(*q.adj);
+		unsigned long long sum = 0; // Wraps around
+		t.start();
+		for (const std::pair<int, int> &p : q.pairs) sum += engine.query(p.first, p.second);
+		t.stop();
+		ops = engine.ops;
+		return sum;
+	}
+};
@@ -0,0 +1,138 @@
+// Records of benchmark runs, printed as a summary table, CSV or JSON lines
+// CSV and JSON have one record per run, with the fields listed in _recordfields. Benchmark/compare.cpp reads the CSV
+// With -perf, the hardware performance counters of the run (perf.cpp) are added after them
+// When compiled with -DHEAPS_COUNTERS, the heap's instrumentation counters (Counters/counters.cpp) are added last
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "perf.cpp"
+#include "../Counters/counters.cpp"
+typedef long long ll;
+struct opcounts // Heap operations performed by a run
+{
+	ll push = 0, pop = 0, decreasekey = 0, merge = 0;
+};
+struct record
+{
+	const char* algorithm;
+	const char* heap;
+	int v, e; // Input parameters
+	ll seed; // Seed the input was generated with, -1 if not given
+	int run;
+	ll answer;
+	ll time; // Nanoseconds
+	opcounts ops;
+	ll peakrss; // Peak resident set of the process while this heap ran, in kB, including the graph. -1 if unknown
+	ll events[perfevents]; // Hardware performance counters, -1 if an event could not be counted
+	heapcounters counters; // Only counted with HEAPS_COUNTERS
+};
+enum recordformat { formattext, formatcsv, formatjson };
+const char* _recordfields = "algorithm,heap,v,e,seed,run,answer,time_ns,push,pop,decreasekey,merge,peakrss_kb";
+const char* _counterfields[] = {"comparisons", "links", "cuts", "touched_push", "touched_pop", "touched_decreasekey", "touched_merge",
+	"activerootreductions", "rootdegreereductions", "lossreductions", "fixlistupdates", "ranklistupdates"};
+void _countervalues(const heapcounters &c, ll* a) // In the order of _counterfields
+{
+	ll values[] = {c.comparisons, c.links, c.cuts, c.touched[heappush], c.touched[heappop], c.touched[heapdecreasekey], c.touched[heapmerge],
+		c.activerootreductions, c.rootdegreereductions, c.lossreductions, c.fixlistupdates, c.ranklistupdates};
+	for (int i = 0; i < 12; i++) a[i] = values[i];
+}
+void printheader(recordformat f, bool perf)
+{
+	if (f != formatcsv) return;
+	printf("%s", _recordfields);
+	if (perf)
+	{
+		for (const char* c : _perfnames) printf(",%s", c);
+	}
+#ifdef HEAPS_COUNTERS
+	for (const char* c : _counterfields) printf(",%s", c);
+#endif
+	printf("\n");
+}
+void printrecord(recordformat f, const record &r, bool perf)
+{
+#ifdef HEAPS_COUNTERS
+	ll counters[12];
+	_countervalues(r.counters, counters);
+#endif
+	if (f == formatcsv)
+	{
+		printf("%s,%s,%d,%d,%lld,%d,%lld,%lld,%lld,%lld,%lld,%lld,%lld", r.algorithm, r.heap, r.v, r.e, r.seed, r.run, r.answer, r.time,
+			r.ops.push, r.ops.pop, r.ops.decreasekey, r.ops.merge, r.peakrss);
+		if (perf)
+		{
+			for (int i = 0; i < perfevents; i++) printf(",%lld", r.events[i]);
+		}
+#ifdef HEAPS_COUNTERS
+		for (int i = 0; i < 12; i++) printf(",%lld", counters[i]);
+#endif
+		printf("\n");
+	}
+	else if (f == formatjson)
+	{
+		printf("{\"algorithm\":\"%s\",\"heap\":\"%s\",\"v\":%d,\"e\":%d,\"seed\":%lld,\"run\":%d,\"answer\":%lld,\"time_ns\":%lld,"
+			"\"push\":%lld,\"pop\":%lld,\"decreasekey\":%lld,\"merge\":%lld,\"peakrss_kb\":%lld", r.algorithm, r.heap, r.v, r.e, r.seed, r.run, r.answer, r.time,
+			r.ops.push, r.ops.pop, r.ops.decreasekey, r.ops.merge, r.peakrss);
+		if (perf)
+		{
+			for (int i = 0; i < perfevents; i++) printf(",\"%s\":%lld", _perfnames[i], r.events[i]);
+		}
+#ifdef HEAPS_COUNTERS
+		for (int i = 0; i < 12; i++) printf(",\"%s\":%lld", _counterfields[i], counters[i]);
+#endif
+		printf("}\n");
+	}
+}
+void printperf(const record* r, int n) // Medians of the hardware performance counters over n runs, for the text format
+{
+	ll median[perfevents];
+	ll* v = new ll[n];
+	for (int i = 0; i < perfevents; i++)
+	{
+		for (int j = 0; j < n; j++) v[j] = r[j].events[i];
+		std::sort(v, v+n);
+		median[i] = v[n/2];
+	}
+	delete[] v;
+	printf("   ");
+	for (int i = 0; i < perfevents; i++)
+	{
+		if (median[i] >= 0) printf(" %s %lld", _perfnames[i], median[i]);
+		else printf(" %s -", _perfnames[i]);
+	}
+	if (median[perfcycles] > 0 && median[perfinstructions] >= 0) printf(", %.2f instructions per cycle", (double)median[perfinstructions]/median[perfcycles]);
+	printf("\n");
+}
+void printcounters(const heapcounters &c) // Summary of the counters for the text format, with the nodes touched per operation
+{
+	const char* names[] = {"push", "pop", "decreasekey", "merge"};
+	printf("    comparisons %lld, links %lld, cuts %lld, nodes touched per", c.comparisons, c.links, c.cuts);
+	for (int i = 0; i < 4; i++) printf(" %s %.2f", names[i], c.operations[i] ? (double)c.touched[i]/c.operations[i] : 0.0);
+	printf("\n");
+	if (c.activerootreductions || c.rootdegreereductions || c.lossreductions)
+	{
+		printf("    active root reductions %lld, root degree reductions %lld, loss reductions %lld, fix list updates %lld, rank list updates %lld\n",
+			c.activerootreductions, c.rootdegreereductions, c.lossreductions, c.fixlistupdates, c.ranklistupdates);
+	}
+}
+// Peak resident set size, from /proc. Resetting it lets each heap be measured separately
+void resetpeakrss()
+{
+	FILE* f = fopen("/proc/self/clear_refs", "w");
+	if (!f) return;
+	fputs("5", f); // Resets the peak resident set size
+	fclose(f);
+}
+ll peakrss() // In kB, -1 if unknown
+{
+	FILE* f = fopen("/proc/self/status", "r");
+	if (!f) return -1;
+	char line[256];
+	ll kb = -1;
+	while (fgets(line, sizeof(line), f))
+	{
+		if (!strncmp(line, "VmHWM:", 6)) sscanf(line+6, "%lld", &kb);
+	}
+	fclose(f);
+	return kb;
+}
@@ -0,0 +1,9 @@
+# deletes all the executable files
+rm benchmark
+rm compare
+rm tocsr
+rm heapsort
+rm heapsort_scalar
+rm benchmark_counters
+rm fuzz
+rm concurrent
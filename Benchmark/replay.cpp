@@ -0,0 +1,70 @@
+// Replays a trace of heap operations (see trace.cpp), the answer is the sum of the keys popped
+// The trace must be valid for every heap: decreasekey and erase only on elements still in the heap, to a smaller key
+// This holds for traces recorded by the benchmark, whose keys are unique, except Edmonds' where keys are only snapshots
+// Erase is a decreasekey to the smallest key followed by a pop, as most of the heaps implement it
+#include <climits>
+#include <utility>
+struct replay
+{
+	static constexpr const char* name = "replay";
+	trace &tr;
+	opcounts ops;
+	opcounts traceops; // Operations in the trace
+	replay(trace &t) : tr(t)
+	{
+		for (const traceop &op : tr.ops)
+		{
+			if (op.type == tracepush) traceops.push++;
+			else if (op.type == tracepop) traceops.pop++;
+			else if (op.type == tracedecreasekey) traceops.decreasekey++;
+			else if (op.type == tracemerge) traceops.merge++;
+			else // Erase
+			{
+				traceops.decreasekey++;
+				traceops.pop++;
+			}
+		}
+	}
+	template<class K> bool supports()
+	{
+		return K::mergeable || !tr.merges;
+	}
+	template<class K> ll run(timer &t)
+	{
+		typedef std::pair<ll, int> key;
+		typedef typename K::template heap<heapvalue<key> > heap;
+		typedef decltype(std::declval<heap&>().push(key())) handle;
+		heap** heaps = new heap*[tr.heaps];
+		for (int i = 0; i < tr.heaps; i++) heaps[i] = new heap();
+		handle* handles = new handle[tr.handles];
+		unsigned long long sum = 0; // Wraps around
+		const key smallest(LLONG_MIN, INT_MIN);
+		ops = traceops;
+		t.start();
+		for (const traceop &op : tr.ops)
+		{
+			heap* h = heaps[op.heap];
+			if (op.type == tracepush) handles[op.other] = h->push(key(op.key, op.tie));
+			else if (op.type == tracepop)
+			{
+				sum += h->top().first;
+				h->pop();
+			}
+			else if (op.type == tracedecreasekey) h->decreasekey(handles[op.other], key(op.key, op.tie));
+			else if (op.type == tracemerge)
+			{
+				if constexpr (K::mergeable) h->merge(heaps[op.other]);
+			}
+			else
+			{
+				h->decreasekey(handles[op.other], smallest);
+				h->pop();
+			}
+		}
+		t.stop();
+		for (int i = 0; i < tr.heaps; i++) delete heaps[i];
+		delete[] heaps;
+		delete[] handles;
+		return sum;
+	}
+};
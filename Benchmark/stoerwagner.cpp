@@ -0,0 +1,151 @@
+// Stoer-Wagner's minimum cut algorithm on an undirected graph, the answer is the weight of the cut
+// Each phase pushes the remaining vertices with key 0 and decreases the key of a vertex by the weight of each edge to it from the legal ordering
+#include <utility>
+struct stoerwagner
+{
+	static constexpr const char* name = "stoer-wagner";
+	struct Edge;
+	typedef Edge* pedge;
+	struct Edge // Adjacency list is stored as a linked list for O(1) merging
+	{
+		pedge adj;
+		int v;
+		ll weight;
+	};
+	graph &g;
+	Edge* edges; // Both directions of each edge
+	ll edgecount;
+	pedge* adj;
+	pedge* lastadj;
+	int* rep; // Union find, for contracted vertices
+	int* inlegal; // Phase in which the vertex was added to the legal ordering
+	ll* key;
+	opcounts ops;
+	stoerwagner(graph &_g) : g(_g)
+	{
+		edgecount = 0; // Edges taken from g, once each
+		for (int a = 0; a < g.v; a++) for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++) edgecount += takes(a, g.targets[j]);
+		edges = new Edge[2*edgecount];
+		adj = new pedge[g.v];
+		lastadj = new pedge[g.v];
+		rep = new int[g.v];
+		inlegal = new int[g.v];
+		key = new ll[g.v];
+	}
+	~stoerwagner()
+	{
+		delete[] edges;
+		delete[] adj;
+		delete[] lastadj;
+		delete[] rep;
+		delete[] inlegal;
+		delete[] key;
+	}
+	bool takes(int a, int b) // A symmetric graph stores each edge twice, it is taken from its smaller vertex. Self loops are never used
+	{
+		return !g.symmetric || a < b;
+	}
+	int findrep(int a)
+	{
+		while (rep[a] != a) a = rep[a] = rep[rep[a]]; // Path halving
+		return a;
+	}
+	void addedge(pedge e, int a, int b, ll c)
+	{
+		e->v = b;
+		e->weight = c;
+		e->adj = adj[a];
+		adj[a] = e;
+		if (!lastadj[a]) lastadj[a] = e;
+	}
+	template<class K> bool supports()
+	{
+		return true;
+	}
+	template<class K> ll run(timer &t)
+	{
+		typedef typename K::template heap<heapvalue<std::pair<ll, int> > > heap; // Negated weight to the legal ordering, and vertex
+		typedef decltype(std::declval<heap&>().push(std::pair<ll, int>())) handle;
+		// Contraction modifies the adjacency lists, so they are rebuilt for every run
+		for (int i = 0; i < g.v; i++)
+		{
+			adj[i] = lastadj[i] = nullptr;
+			rep[i] = i;
+			inlegal[i] = 0;
+		}
+		pedge next = edges;
+		for (int a = 0; a < g.v; a++)
+		{
+			for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
+			{
+				int b = g.targets[j];
+				if (!takes(a, b)) continue;
+				addedge(next++, a, b, g.weights[j]);
+				addedge(next++, b, a, g.weights[j]);
+			}
+		}
+		handle* nodes = new handle[g.v];
+		ll ans = 1e18;
+		ops = opcounts();
+		t.start();
+		{
+			heap pq;
+			for (int c = 1; c <= g.v-1; c++) // Run this v-1 times
+			{
+				// Construct "legal ordering"
+				// Push all nodes onto the pq
+				for (int i = 0; i < g.v; i++)
+				{
+					if (findrep(i) == i) // If it hasn't been contracted
+					{
+						key[i] = 0;
+						nodes[i] = pq.push(std::make_pair(0ll, i));
+						ops.push++;
+					}
+				}
+				int last = -1;
+				while (pq.size() > 1)
+				{
+					int a = pq.top().second; // A is the next node in the legal ordering
+					last = a;
+					inlegal[a] = c;
+					pq.pop();
+					ops.pop++;
+					for (pedge e = adj[a]; e; e = e->adj)
+					{
+						// For each outgoing edge, do a decrease-key
+						int b = findrep(e->v);
+						if (inlegal[b] != c)
+						{
+							key[b] -= e->weight;
+							pq.decreasekey(nodes[b], std::make_pair(key[b], b));
+							ops.decreasekey++;
+						}
+					}
+				}
+				ans = std::min(ans, -pq.top().first); // Update answer if needed
+				int a = pq.top().second;
+				pq.pop();
+				ops.pop++;
+				// Merge a and last
+				rep[findrep(a)] = findrep(last);
+				if (adj[a])
+				{
+					if (adj[last])
+					{
+						lastadj[a]->adj = adj[last];
+						adj[last] = adj[a];
+					}
+					else
+					{
+						adj[last] = adj[a];
+						lastadj[last] = lastadj[a];
+					}
+				}
+			}
+		}
+		t.stop();
+		delete[] nodes;
+		return ans;
+	}
+};
@@ -0,0 +1,43 @@
+// Timing with a monotonic clock at nanosecond resolution, and statistics over repeated runs
+// A timer can also read hardware performance counters (perf.cpp) around the same region
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "perf.cpp"
+typedef long long ll;
+struct timer // An algorithm starts and stops the timer around the region it wants measured
+{
+	std::chrono::steady_clock::time_point begin;
+	ll elapsed = 0; // Nanoseconds between start() and stop()
+	perfcounters* perf = nullptr; // If set, counted between start() and stop(), outside the clock
+	ll events[perfevents]; // The counts, -1 without perf
+	void start()
+	{
+		if (perf) perf->start();
+		begin = std::chrono::steady_clock::now();
+	}
+	void stop()
+	{
+		elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+		if (perf) perf->stop();
+		for (int i = 0; i < perfevents; i++) events[i] = perf ? perf->values[i] : -1;
+	}
+};
+struct runstats // Summary of the times of repeated runs, in nanoseconds
+{
+	ll min, median, max;
+	double mean, stddev;
+	runstats(ll* t, int n) // Sorts t
+	{
+		std::sort(t, t+n);
+		min = t[0];
+		max = t[n-1];
+		median = n%2 ? t[n/2] : (t[n/2-1] + t[n/2])/2;
+		mean = 0;
+		for (int i = 0; i < n; i++) mean += t[i];
+		mean /= n;
+		stddev = 0;
+		for (int i = 0; i < n; i++) stddev += (t[i] - mean)*(t[i] - mean);
+		stddev = n > 1 ? sqrt(stddev/(n-1)) : 0;
+	}
+};
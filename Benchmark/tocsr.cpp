@@ -0,0 +1,28 @@
+// Converts a graph in the text format of the generators to the binary CSR format (see ../Graph/csr.cpp)
+// Usage: ./tocsr [-undirected] < in.txt > out.csr
+// undirected stores every edge in both directions, as Dijkstra's algorithm and Stoer-Wagner use it, so the benchmark does not have to
+// Without it, the edges are stored as given, which Edmonds' algorithm needs
+#include <cstdio>
+#include <cstring>
+#include "../Graph/csr.cpp"
+int main(int argc, char** argv)
+{
+	bool undirected = argc > 1 && !strcmp(argv[1], "-undirected");
+	if (argc > 2 || (argc == 2 && !undirected))
+	{
+		fprintf(stderr, "Usage: %s [-undirected] < in.txt > out.csr\n", argv[0]);
+		return 1;
+	}
+	csrgraph g;
+	if (!g.readtext(stdin, undirected))
+	{
+		fprintf(stderr, "Malformed input\n");
+		return 1;
+	}
+	if (!g.write(stdout) || fflush(stdout))
+	{
+		fprintf(stderr, "Could not write the output\n");
+		return 1;
+	}
+	return 0;
+}
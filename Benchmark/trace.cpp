@@ -0,0 +1,212 @@
+// Traces of heap operations, so a heap can be measured on a recorded sequence of operations without the algorithm around it
+// A trace can be recorded from a benchmark run (./benchmark algorithm heap -trace file), or written by any program with tracewriter
+// Format, all integers are LEB128 varints, keys and ties are zigzag encoded first:
+//   "HEAPTRC1", then the number of heaps, handles and operations, then the operations
+//   Each operation is a byte followed by its fields:
+//   0 push: heap, key, tie          The new element gets the next handle id, starting from 0
+//   1 pop: heap                     Pops the minimum (top() then pop())
+//   2 decreasekey: heap, handle, key, tie
+//   3 merge: heap, other heap       Merges the other heap into heap, the other heap is then empty
+//   4 erase: heap, handle
+// Keys are (key, tie) pairs compared lexicographically, e.g. (distance, vertex). Heaps are numbered from 0
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <utility>
+typedef long long ll;
+enum traceoperation { tracepush, tracepop, tracedecreasekey, tracemerge, traceerase };
+struct traceop // A decoded operation
+{
+	int type;
+	int heap;
+	int other; // Handle for decreasekey and erase, heap for merge
+	ll key;
+	int tie;
+};
+void _traceput(std::vector<unsigned char> &bytes, unsigned long long a) // Appends a as a varint
+{
+	while (a >= 128)
+	{
+		bytes.push_back((a & 127) | 128);
+		a >>= 7;
+	}
+	bytes.push_back(a);
+}
+struct tracewriter
+{
+	std::vector<unsigned char> bytes; // Operations, encoded
+	ll heaps = 0, handles = 0, operations = 0;
+	void put(unsigned long long a)
+	{
+		_traceput(bytes, a);
+	}
+	void putsigned(ll a)
+	{
+		put(((unsigned long long)a << 1) ^ (unsigned long long)(a >> 63)); // Zigzag, so small negative numbers stay short
+	}
+	void begin(int type, int heap)
+	{
+		operations++;
+		bytes.push_back(type);
+		put(heap);
+		if (heap >= heaps) heaps = heap+1;
+	}
+	ll push(int heap, ll key, int tie) // Returns the handle id of the new element
+	{
+		begin(tracepush, heap);
+		putsigned(key);
+		putsigned(tie);
+		return handles++;
+	}
+	void pop(int heap)
+	{
+		begin(tracepop, heap);
+	}
+	void decreasekey(int heap, ll handle, ll key, int tie)
+	{
+		begin(tracedecreasekey, heap);
+		put(handle);
+		putsigned(key);
+		putsigned(tie);
+	}
+	void merge(int heap, int other)
+	{
+		begin(tracemerge, heap);
+		put(other);
+		if (other >= heaps) heaps = other+1;
+	}
+	void erase(int heap, ll handle)
+	{
+		begin(traceerase, heap);
+		put(handle);
+	}
+	bool save(const char* filename)
+	{
+		FILE* f = fopen(filename, "wb");
+		if (!f) return false;
+		const char* magic = "HEAPTRC1";
+		std::vector<unsigned char> header(magic, magic+8);
+		_traceput(header, heaps);
+		_traceput(header, handles);
+		_traceput(header, operations);
+		bool ok = fwrite(header.data(), 1, header.size(), f) == header.size() && fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+		return fclose(f) == 0 && ok;
+	}
+};
+struct trace
+{
+	int heaps = 0;
+	ll handles = 0;
+	std::vector<traceop> ops;
+	bool merges = false, erases = false; // Whether the trace has any
+	bool read(FILE* in) // Returns false if the input is not a valid trace
+	{
+		std::vector<unsigned char> bytes;
+		unsigned char buffer[1 << 16];
+		size_t n;
+		while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) bytes.insert(bytes.end(), buffer, buffer+n);
+		if (bytes.size() < 8 || memcmp(bytes.data(), "HEAPTRC1", 8)) return false;
+		size_t at = 8;
+		bool ok = true;
+		auto get = [&]() -> unsigned long long
+		{
+			unsigned long long a = 0;
+			for (int shift = 0; ; shift += 7)
+			{
+				if (at >= bytes.size() || shift > 63)
+				{
+					ok = false;
+					return 0;
+				}
+				unsigned char b = bytes[at++];
+				a |= (unsigned long long)(b & 127) << shift;
+				if (!(b & 128)) return a;
+			}
+		};
+		auto getsigned = [&]() -> ll
+		{
+			unsigned long long a = get();
+			return (ll)(a >> 1) ^ -(ll)(a & 1);
+		};
+		heaps = get();
+		handles = get();
+		ll operations = get();
+		if (!ok || heaps < 0 || handles < 0 || operations < 0) return false;
+		ops.resize(operations);
+		ll pushed = 0;
+		for (traceop &op : ops)
+		{
+			if (at >= bytes.size()) return false;
+			op.type = bytes[at++];
+			op.heap = get();
+			op.other = 0;
+			op.key = 0;
+			op.tie = 0;
+			if (op.type == tracepush)
+			{
+				op.other = pushed++;
+				op.key = getsigned();
+				op.tie = getsigned();
+			}
+			else if (op.type == tracedecreasekey)
+			{
+				op.other = get();
+				op.key = getsigned();
+				op.tie = getsigned();
+			}
+			else if (op.type == tracemerge || op.type == traceerase) op.other = get();
+			else if (op.type != tracepop) return false;
+			if (!ok || op.heap >= heaps) return false;
+			if (op.type == tracemerge && op.other >= heaps) return false;
+			if ((op.type == tracedecreasekey || op.type == traceerase) && op.other >= pushed) return false;
+			merges |= op.type == tracemerge;
+			erases |= op.type == traceerase;
+		}
+		return pushed == handles;
+	}
+};
+
+// Recording: tracedkind<K> runs heap K and writes every operation on it to _tracing
+// The keys are given by _tracekey() of the values passed to push() and decreasekey()
+inline tracewriter* _tracing = nullptr;
+template<class A, class B> std::pair<ll, int> _tracekey(const std::pair<A, B> &a)
+{
+	return {a.first, a.second};
+}
+template<class X> struct tracehandle // The heap's handle, and its id in the trace
+{
+	X handle;
+	ll id;
+};
+template<class H> struct tracedheap : H
+{
+	int id = _tracing->heaps++;
+	template<class T> auto push(const T &val) -> tracehandle<decltype(H::push(val))>
+	{
+		std::pair<ll, int> k = _tracekey(val);
+		ll handle = _tracing->push(id, k.first, k.second);
+		return {H::push(val), handle};
+	}
+	void pop()
+	{
+		_tracing->pop(id);
+		H::pop();
+	}
+	template<class X, class T> void decreasekey(const tracehandle<X> &a, const T &val)
+	{
+		std::pair<ll, int> k = _tracekey(val);
+		_tracing->decreasekey(id, a.id, k.first, k.second);
+		H::decreasekey(a.handle, val);
+	}
+	void merge(tracedheap* a)
+	{
+		_tracing->merge(id, a->id);
+		H::merge(a);
+	}
+};
+template<class K> struct tracedkind
+{
+	template<class T> using heap = tracedheap<typename K::template heap<T> >;
+	static constexpr const char* name = K::name;
+	static constexpr bool mergeable = K::mergeable;
+};
@@ -1,4 +1,6 @@
 // Binomial heap with push, pop, top (minimum), merge, decrease key, delete
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 template<class T> struct BinomialNode;
 template<class T> struct BinomialHeapNode // The actual node in the heap
 {
@@ -13,31 +15,35 @@ template<class T> struct BinomialNode // The value, stores a pointer to its node
 	typedef struct BinomialHeapNode<T>* pnode;
 	T val;
 	pnode inheap;
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 };
 
-template<class T> BinomialHeapNode<T>* _binomialnewheapnode(BinomialNode<T>* val)
+template<class T, class A> BinomialHeapNode<T>* _binomialnewheapnode(A &alloc, BinomialNode<T>* val)
 {
 	typedef struct BinomialHeapNode<T>* pnode;
-	pnode _new = new BinomialHeapNode<T>(); // Other method of allocating memory
+	pnode _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
 
-template<class T> BinomialNode<T>* _binomialnewnode(T val)
+template<class T, class A> BinomialNode<T>* _binomialnewnode(A &alloc, T val)
 {
 	typedef struct BinomialNode<T>* pvalue;
-	pvalue _new = new BinomialNode<T>(); // Other method of allocating memory
+	pvalue _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
 
-template<class T> struct binomial
+template<class T, template<class> class Alloc = freelistallocator> struct binomial
 {
 	typedef struct BinomialHeapNode<T>* pnode;
 	typedef struct BinomialNode<T>* pvalue;
+	Alloc<BinomialHeapNode<T> > heapalloc; // Allocates the nodes in the heap
+	Alloc<BinomialNode<T> > valuealloc; // Allocates the values
 	pnode root = 0;
 	int sz = 0;
 	pnode mn = 0;
+	bool ownshandles = true; // Whether popped values it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Auxiliary functions
 	int size()
 	{
@@ -57,6 +63,11 @@ template<class T> struct binomial
 		a = b;
 		b = c;
 	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, and its value unless the caller owns it
+	{
+		if (ownshandles && !a->val->callerowned) valuealloc.deallocate(a->val);
+		heapalloc.deallocate(a);
+	}
 	pnode mergetrees(pnode a, pnode b, pnode pre = 0) // Merges trees with equal degree, creating one tree with degree+1
 	{
 		if (b->val->val < a->val->val)
@@ -68,6 +79,7 @@ template<class T> struct binomial
 			swap(a, b);
 		}
 		// Make tree b the child of tree a
+		HEAPLINK();
 		a->sibling = b->sibling;
 		a->degree++;
 		b->sibling = a->child;
@@ -80,6 +92,7 @@ template<class T> struct binomial
 	// Main functions
 	void push(pnode _new)
 	{
+		HEAPOP(push);
 		_new->val->inheap = _new;
 		// Worst case O(log(n)) - average O(1)
 		sz++;
@@ -91,14 +104,15 @@ template<class T> struct binomial
 			_new = mergetrees(_new, _new->sibling);
 		}
 	}
-	void push(pvalue val)
+	void push(pvalue val) // Inserts a value owned by the caller
 	{
-		push(_binomialnewheapnode<T>(val));
+		val->callerowned = true;
+		push(_binomialnewheapnode<T>(heapalloc, val));
 	}
-	pvalue push(T val)
+	pvalue push(T val) // The returned value is valid until it is popped
 	{
-		pvalue _new = _binomialnewnode<T>(val);
-		push(_new);
+		pvalue _new = _binomialnewnode<T>(valuealloc, val);
+		push(_binomialnewheapnode<T>(heapalloc, _new));
 		return _new;
 	}
 	void merge(pnode b)
@@ -163,16 +177,23 @@ template<class T> struct binomial
 	void merge(binomial* A)
 	{
 		if (!A->root) return;
+		HEAPOP(merge);
 		sz += A->sz;
+		// Nodes and values of A are now owned by this heap
+		heapalloc.merge(A->heapalloc);
+		valuealloc.merge(A->valuealloc);
+		ownshandles = ownshandles && A->ownshandles; // Values of A stay valid after pop if A kept them
 		merge(A->root);		
 	}
 	void pop()
 	{
+		HEAPOP(pop);
 		sz--;
 		pnode a = root;
 		pnode pre = 0;
 		while (a != mn) // Find the tree with mn
 		{
+			HEAPTOUCH(1);
 			pre = a;
 			a = a->sibling;
 		}	
@@ -188,10 +209,12 @@ template<class T> struct binomial
 		}
 
 		// Reverse the linked list of A's children
+		pnode old = a; // Recycled once its children are back in the heap
 		pre = 0;
 		a = a->child;
 		while (a)
 		{
+			HEAPTOUCH(1);
 			pnode next = a->sibling;
 			a->sibling = pre;
 			pre = a;
@@ -203,16 +226,19 @@ template<class T> struct binomial
 			pnode b = root;
 			while (b)
 			{
+				HEAPTOUCH(1);
 				if (mn == 0 || b->val->val < mn->val->val) mn = b;
 				b = b->sibling;
 			}
 		}
+		reclaim(old);
 	}
 	void decreasekey(pnode &a, pvalue val)
 	{
 		while (a->par && a->par->val->val > val->val)
 		{
 			// Swap a and its parent
+			HEAPTOUCH(1);
 			a->val = a->par->val;
 			a->val->inheap = a;
 			a = a->par;
@@ -222,14 +248,25 @@ template<class T> struct binomial
 	}
 	void decreasekey(pvalue a, T val)
 	{
+		HEAPOP(decreasekey);
 		a->val = val;
 		decreasekey(a->inheap, a);
 	}
-	void erase(pnode a) // Remove a node from the heap
+	void erase(pvalue a) // Remove a value from the heap
 	{
-		// Update the value to -infinity
-		decreasekey(a, -(1 << 30));
-		// Since a should now be the greatest element, pop
+		// Move a up to the root of its tree, as decreasekey does but without comparing keys
+		pnode b = a->inheap;
+		while (b->par)
+		{
+			HEAPTOUCH(1);
+			b->val = b->par->val;
+			b->val->inheap = b;
+			b = b->par;
+		}
+		b->val = a;
+		a->inheap = b;
+		// Pop it as if it was the minimum, pop finds the real minimum again
+		mn = b;
 		pop();
 	}
 };
\ No newline at end of file
@@ -0,0 +1,165 @@
+// Bucket queue (minimum) for monotone integer keys with a bounded spread, as in Dial's algorithm, with push, pop, top & decrease key
+// O(1) push, decrease key & erase, pop moves past the empty buckets up to the next key
+// C is the largest difference between a key in the heap and the last key popped, e.g. the largest edge weight in Dijkstra's algorithm
+// Monotone: every key pushed or decreased to must be between the last key popped (or seen by top) and that key + C
+// Keys are integers, or std::pair<integer, X> where only the first element is used to place the pair in a bucket
+// Ties between equal keys are broken arbitrarily
+// Single level: a circular array of at least C+1 buckets, one key per bucket, so C should be small (e.g. weights below a few million)
+// Two level: about sqrt(C) bottom buckets for the keys in the current block, and about sqrt(C) top buckets of one block each
+// A top bucket is spread into the bottom buckets once the heap reaches its block
+// A single level queue whose C needs more than maxwidth buckets uses two levels instead. C must be below 2^52 (throws std::length_error)
+#include <utility>
+#include <stdexcept>
+#include "../Allocator/allocator.cpp"
+template<class T> unsigned long long _bucketkey(const T &a)
+{
+	return a;
+}
+template<class A, class B> unsigned long long _bucketkey(const std::pair<A, B> &a)
+{
+	return a.first;
+}
+template<class T> struct BucketNode
+{
+	typedef struct BucketNode<T>* pnode;
+	T val; // Value of the node
+	int bucket; // Bucket the node is in
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
+	pnode left, right; // Neighbours in the bucket
+};
+template<class T, template<class> class Alloc = freelistallocator, bool TwoLevel = false> struct bucket
+{
+	typedef struct BucketNode<T>* pnode;
+	Alloc<BucketNode<T> > alloc; // Allocates the nodes of this heap
+	pnode* head = nullptr; // First node in each bucket, the bottom buckets then the top buckets
+	static const long long maxwidth = 1 << 24; // Most buckets in a level
+	bool twolevel = TwoLevel;
+	long long width = 1; // Number of bottom buckets, a power of two
+	int logwidth = 0;
+	long long tops = 0; // Number of top buckets, a power of two (two level only)
+	unsigned long long last = 0; // Last key popped, every key in the heap is at least this
+	int sz = 0;
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
+	bucket(long long C)
+	{
+		if (C >= 1ll << 52) throw std::length_error("bucket: C must be below 2^52");
+		if (C >= maxwidth) twolevel = true; // One bucket per key would not fit
+		if (twolevel)
+		{
+			while (width*width < C+1) width *= 2, logwidth++;
+			tops = 1;
+			while (tops < C/width + 2) tops *= 2; // Keys span at most C/width+2 blocks, one of which is in the bottom buckets
+		}
+		else
+		{
+			while (width < C+1) width *= 2, logwidth++;
+		}
+		head = new pnode[width + tops]();
+	}
+	bucket(const bucket&) = delete; // Owns its buckets
+	bucket& operator=(const bucket&) = delete;
+	~bucket()
+	{
+		delete[] head;
+	}
+	// Auxilary functions
+	int size()
+	{
+		return sz;
+	}
+	bool empty()
+	{
+		return !sz;
+	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
+	int index(unsigned long long key) // The bucket key belongs in
+	{
+		if (twolevel && (key >> logwidth) != (last >> logwidth)) return width + ((key >> logwidth) & (tops-1)); // Not in the current block
+		return key & (width-1);
+	}
+	void link(pnode a) // Adds a to the front of its bucket
+	{
+		int b = index(_bucketkey(a->val));
+		a->bucket = b;
+		a->left = nullptr;
+		a->right = head[b];
+		if (a->right) a->right->left = a;
+		head[b] = a;
+	}
+	void unlink(pnode a) // Removes a from its bucket
+	{
+		if (a->left) a->left->right = a->right;
+		else head[a->bucket] = a->right;
+		if (a->right) a->right->left = a->left;
+	}
+	void pull() // Moves last up to the smallest key, so that its bucket is not empty
+	{
+		while (!head[last & (width-1)])
+		{
+			if (!twolevel || (long long)(last & (width-1)) != width-1)
+			{
+				last++;
+				continue;
+			}
+			// The current block is empty, find the next non-empty top bucket and spread it into the bottom buckets
+			unsigned long long b = (last >> logwidth) + 1;
+			while (!head[width + (b & (tops-1))]) b++;
+			last = b << logwidth;
+			pnode a = head[width + (b & (tops-1))];
+			head[width + (b & (tops-1))] = nullptr;
+			while (a)
+			{
+				pnode next = a->right;
+				link(a);
+				a = next;
+			}
+		}
+	}
+
+	// Main functions
+	T top()
+	{
+		pull();
+		return head[last & (width-1)]->val;
+	}
+	void push(pnode a) // Inserts a node owned by the caller
+	{
+		a->callerowned = true;
+		sz++;
+		link(a);
+	}
+	pnode push(T val) // The returned node is valid until it is popped
+	{
+		pnode a = alloc.allocate();
+		a->val = val;
+		sz++;
+		link(a);
+		return a;
+	}
+	void pop()
+	{
+		pull();
+		pnode a = head[last & (width-1)];
+		unlink(a);
+		sz--;
+		reclaim(a);
+	}
+	void decreasekey(pnode a, T val) // Relocates a to the bucket of its new key
+	{
+		a->val = val;
+		if (index(_bucketkey(val)) != a->bucket)
+		{
+			unlink(a);
+			link(a);
+		}
+	}
+	void erase(pnode a)
+	{
+		unlink(a);
+		sz--;
+		reclaim(a);
+	}
+};
@@ -0,0 +1,122 @@
+// Instrumentation counters for the heaps, compiled in only when HEAPS_COUNTERS is defined, otherwise the macros are empty
+// The heaps count links, cuts, and nodes touched by each kind of operation into the global _heapcounters
+// A link makes one tree the child of another, a cut removes a subtree from its parent, both touch two nodes
+// Nodes touched also counts every node visited while scanning root lists, children, paths to the root and d-ary levels
+// Comparisons are counted by the value type: use counted<T> in place of T
+// The strict Fibonacci heap also counts its transformations and its fix list and rank list updates
+#ifndef HEAPS_COUNTERS_H
+#define HEAPS_COUNTERS_H
+#include <type_traits>
+enum heapoperation { heappush, heappop, heapdecreasekey, heapmerge };
+struct heapcounters
+{
+	long long comparisons = 0;
+	long long links = 0, cuts = 0;
+	long long operations[4] = {}; // Number of each kind of operation, so the counts can be averaged
+	long long touched[4] = {}; // Nodes touched by each kind of operation
+	int current = heappush; // Operation in progress
+	// Strict Fibonacci heap
+	long long activerootreductions = 0, rootdegreereductions = 0, lossreductions = 0;
+	long long fixlistupdates = 0, ranklistupdates = 0; // Nodes inserted into, moved within or removed from the fix list, and rank changes
+	heapcounters& operator+=(const heapcounters &b) // Adds the counts of b, e.g. to total separate phases
+	{
+		comparisons += b.comparisons;
+		links += b.links;
+		cuts += b.cuts;
+		for (int i = 0; i < 4; i++)
+		{
+			operations[i] += b.operations[i];
+			touched[i] += b.touched[i];
+		}
+		activerootreductions += b.activerootreductions;
+		rootdegreereductions += b.rootdegreereductions;
+		lossreductions += b.lossreductions;
+		fixlistupdates += b.fixlistupdates;
+		ranklistupdates += b.ranklistupdates;
+		return *this;
+	}
+};
+#ifdef HEAPS_COUNTERS
+inline heapcounters _heapcounters;
+#define HEAPOP(op) (_heapcounters.operations[heap##op]++, _heapcounters.current = heap##op) // Start of a push, pop, decreasekey or merge
+#define HEAPLINK() (_heapcounters.links++, _heapcounters.touched[_heapcounters.current] += 2)
+#define HEAPCUT() (_heapcounters.cuts++, _heapcounters.touched[_heapcounters.current] += 2)
+#define HEAPTOUCH(n) (_heapcounters.touched[_heapcounters.current] += (n))
+#define HEAPCOUNT(counter) (_heapcounters.counter++)
+#else
+#define HEAPOP(op) ((void)0)
+#define HEAPLINK() ((void)0)
+#define HEAPCUT() ((void)0)
+#define HEAPTOUCH(n) ((void)0)
+#define HEAPCOUNT(counter) ((void)0)
+#endif
+
+// Value types that count their comparisons. Classes are inherited from, so their members can still be used
+template<class T, bool IsClass = std::is_class<T>::value> struct counted : T
+{
+	counted()
+	{
+	}
+	counted(const T &a) : T(a)
+	{
+	}
+	const T& base() const
+	{
+		return *this;
+	}
+	bool operator<(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return base() < b.base();
+	}
+	bool operator>(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return base() > b.base();
+	}
+	bool operator<=(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return base() <= b.base();
+	}
+	bool operator>=(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return base() >= b.base();
+	}
+};
+template<class T> struct counted<T, false> // Numbers are stored, and converted back implicitly
+{
+	T val;
+	counted()
+	{
+	}
+	counted(T a) : val(a)
+	{
+	}
+	operator T() const
+	{
+		return val;
+	}
+	bool operator<(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return val < b.val;
+	}
+	bool operator>(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return val > b.val;
+	}
+	bool operator<=(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return val <= b.val;
+	}
+	bool operator>=(const counted &b) const
+	{
+		HEAPCOUNT(comparisons);
+		return val >= b.val;
+	}
+};
+#endif
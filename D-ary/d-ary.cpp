@@ -1,13 +1,113 @@
 // Minimum D-ary heap, generalisation of binary heap
 // O(log) push, pop, decrease key
-#define D 4
-#define MAXN 1000000
-template<class T> struct dary
+// D is the number of children of each node, storage grows on demand or can be reserved up front
+// The index of a popped node is reused by a later push, so storage grows with the largest size the heap reaches, not the number of pushes
+// For int and long long keys with D = 4, 8 or 16, the smallest child is found with SIMD (SSE4.1/AVX2) when it is enabled
+// Define DARY_SCALAR to always use the scalar loop
+// In the aligned layout, each group of siblings starts on a 64 byte boundary (keys are stored apart from the node/at index arrays)
+// It needs D * sizeof(T) to be a multiple of 64 or to divide 64, so that no group straddles two cache lines
+#if !defined(DARY_SCALAR) && (defined(__SSE4_1__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+#include <new>
+#include "../Counters/counters.cpp"
+template<class X> void _daryresize(X* &a, int n, int cap) // Moves the first n elements of a into an array of size cap
 {
-	T heap[MAXN];
-	int node[MAXN]; // The index of the node here
-	int at[MAXN]; // Where is the node with this index
-	int upto, sz;
+	X* _new = new X[cap];
+	for (int i = 0; i < n; i++) _new[i] = a[i];
+	delete[] a;
+	a = _new;
+}
+constexpr int _darylog(int d) // log2(d), for d a power of two
+{
+	return d <= 1 ? 0 : 1 + _darylog(d/2);
+}
+// Finding the smallest of D consecutive children. Returns its offset, the first one if there are several
+template<class T> int _daryminscalar(const T* a, int d)
+{
+	int mn = 0;
+	for (int i = 1; i < d; i++)
+	{
+		if (a[i] < a[mn]) mn = i;
+	}
+	return mn;
+}
+template<class T, int D> struct _darymin // Scalar version, used for all other key types
+{
+	static int find(const T* a)
+	{
+		return _daryminscalar(a, D);
+	}
+};
+#if !defined(DARY_SCALAR) && defined(__AVX2__)
+template<int D> struct _darymin<long long, D> // Four keys per vector. Takes the minimum of the vectors, then of the lanes, then finds which lane held it
+{
+	static __m256i min(__m256i a, __m256i b)
+	{
+		return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+	}
+	static int find(const long long* a)
+	{
+		if (D%4 || D > 16) return _daryminscalar(a, D);
+		__m256i v[D/4];
+		for (int i = 0; i < D/4; i++) v[i] = _mm256_loadu_si256((const __m256i*)(a + 4*i));
+		__m256i m = v[0];
+		for (int i = 1; i < D/4; i++) m = min(m, v[i]);
+		m = min(m, _mm256_permute4x64_epi64(m, 0x4e)); // Swap the 128-bit halves
+		m = min(m, _mm256_shuffle_epi32(m, 0x4e)); // Swap the 64-bit lanes within each half, every lane now holds the minimum
+		int mask = 0;
+		for (int i = 0; i < D/4; i++) mask |= _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v[i], m))) << (4*i);
+		return __builtin_ctz(mask);
+	}
+};
+#endif
+#if !defined(DARY_SCALAR) && defined(__SSE4_1__)
+template<int D> struct _darymin<int, D> // Same as above, four keys per 128-bit vector
+{
+	static int find(const int* a)
+	{
+		if (D%4 || D > 16) return _daryminscalar(a, D);
+		__m128i v[D/4];
+		for (int i = 0; i < D/4; i++) v[i] = _mm_loadu_si128((const __m128i*)(a + 4*i));
+		__m128i m = v[0];
+		for (int i = 1; i < D/4; i++) m = _mm_min_epi32(m, v[i]);
+		m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0x4e)); // Swap the 64-bit halves
+		m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0xb1)); // Swap neighbouring lanes, every lane now holds the minimum
+		int mask = 0;
+		for (int i = 0; i < D/4; i++) mask |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v[i], m))) << (4*i);
+		return __builtin_ctz(mask);
+	}
+};
+#endif
+template<class T, int D = 4, bool Aligned = false> struct dary
+{
+	static constexpr bool POW2 = (D & (D-1)) == 0; // If D is a power of two, use shifts instead of multiplying and dividing
+	static constexpr int LOGD = _darylog(D);
+	// In the aligned layout, the root is stored D-1 slots after a 64 byte boundary
+	// The children of a start at a*D+1, which is then (a+1)*D slots from the boundary
+	static constexpr int OFFSET = Aligned ? D-1 : 0;
+	static_assert(!Aligned || (D*sizeof(T)) % 64 == 0 || 64 % (D*sizeof(T)) == 0, "dary: the aligned layout needs D * sizeof(T) to be a multiple of 64 or to divide 64");
+	T* heapbase = nullptr; // The allocated array, on a 64 byte boundary in the aligned layout. heap points into it
+	T* heap = nullptr;
+	int* node = nullptr; // The index of the node here. Positions sz..upto-1 hold the popped nodes, whose indices are free
+	int* at = nullptr; // Where is the node with this index
+	int upto = 0, sz = 0; // Number of indices handed out, and of elements in the heap
+	int cap = 0; // Size of heap, node and at
+	dary()
+	{
+	}
+	dary(int n) // Reserves space for n elements
+	{
+		reserve(n);
+	}
+	dary(const dary&) = delete; // Owns its arrays
+	dary& operator=(const dary&) = delete;
+	~dary()
+	{
+		release(heapbase, cap + OFFSET);
+		delete[] node;
+		delete[] at;
+	}
 
 	// Auxilary functions
 	int size()
@@ -22,6 +122,50 @@ template<class T> struct dary
 	{
 		return heap[0];
 	}
+	static T* allocate(int n) // An array of n keys, starting on a 64 byte boundary in the aligned layout
+	{
+		if constexpr (!Aligned) return new T[n];
+		else
+		{
+			T* a = (T*)::operator new[](n * sizeof(T), std::align_val_t(64));
+			for (int i = 0; i < n; i++) new (a + i) T();
+			return a;
+		}
+	}
+	static void release(T* a, int n)
+	{
+		if constexpr (!Aligned) delete[] a;
+		else if (a)
+		{
+			for (int i = 0; i < n; i++) a[i].~T();
+			::operator delete[](a, std::align_val_t(64));
+		}
+	}
+	void resizeheap(int n) // Moves the keys into an array with room for n
+	{
+		T* base = allocate(n + OFFSET);
+		T* _new = base + OFFSET;
+		for (int i = 0; i < upto; i++) _new[i] = heap[i]; // Including popped keys, heap[at[index]] of a popped node stays valid until its index is reused
+		release(heapbase, cap + OFFSET);
+		heapbase = base;
+		heap = _new;
+	}
+	void reserve(int n) // Makes room for n elements in the heap
+	{
+		if (n <= cap) return;
+		resizeheap(n);
+		_daryresize(node, upto, n);
+		_daryresize(at, upto, n);
+		cap = n;
+	}
+	int parent(int a)
+	{
+		return POW2 ? (a-1) >> LOGD : (a-1)/D;
+	}
+	int firstchild(int a)
+	{
+		return POW2 ? (a << LOGD) + 1 : a*D+1;
+	}
 	void swap(int a, int b) // Swaps two elements in the heap
 	{
 		T c = heap[a];
@@ -35,64 +179,86 @@ template<class T> struct dary
 		at[node[a]] = a;
 		at[node[b]] = b;
 	}
-	void bubbleup(int a) // Swaps with parents until its in the correct position
+	void place(int a, T val, int n) // Puts node n with value val at position a
 	{
+		heap[a] = val;
+		node[a] = n;
+		at[n] = a;
+	}
+	void bubbleup(int a) // Moves parents down until it is in the correct position
+	{
+		T val = heap[a];
+		int n = node[a];
 		while (a)
 		{
-			int p = (a-1)/D;
-			if (heap[a] < heap[p]) // Should perform the swap
+			int p = parent(a);
+			HEAPTOUCH(1);
+			if (val < heap[p]) // Should perform the swap
 			{
-				swap(a, p);
+				place(a, heap[p], node[p]);
 				a = p;
 			}
 			else break; // We are finished
 		}
+		place(a, val, n);
 	}
-	void bubbledown(int a) // Swaps with children until its in the correct position
-	{
+	void bubbledown(int a) // Moves children up until it is in the correct position
+	{	// Only the keys are read to choose a child, node and at are written once per level
+		T val = heap[a];
+		int n = node[a];
 		while (true)
 		{
-			T mn = heap[a];
-			int mnchild = -1;
-			for (int i = 1; i <= D; i++)
+			int c = firstchild(a);
+			if (c >= sz) break; // Leaf, we are done
+			HEAPTOUCH(c+D <= sz ? D : sz-c);
+			int mnchild = c;
+			if (c+D <= sz) mnchild += _darymin<T, D>::find(heap + c); // All D children exist
+			else
 			{
-				int c = a*D+i;
-				if (c < sz && heap[c] < mn) // This is the new greatest value
+				for (c++; c < sz; c++)
 				{
-					mn = heap[c];
-					mnchild = c;
+					if (heap[c] < heap[mnchild]) mnchild = c; // This is the new smallest value
 				}
 			}
-			if (mnchild == -1) break; // We are done
-			swap(a, mnchild);
+			if (!(heap[mnchild] < val)) break; // We are done
+			place(a, heap[mnchild], node[mnchild]);
 			a = mnchild;
 		}
+		place(a, val, n);
 	}
 
 	// Main functions
-	void push(T val)
+	int push(T val) // Returns the index of the new node, its position in the heap is at[index]. The index is valid until the node is popped
 	{
-		// Insert as a leaf
+		HEAPOP(push);
+		if (sz == upto) // Every index is in use, hand out a new one
+		{
+			if (upto == cap) reserve(cap ? 2*cap : 16); // Double the arrays when they are full
+			node[upto] = upto;
+			upto++;
+		}
+		// Insert as a leaf, taking the index of the node popped from this position
+		int n = node[sz];
 		heap[sz] = val;
-		node[sz] = upto;
-		at[upto++] = sz;
+		at[n] = sz;
 		// Bubble up
 		bubbleup(sz++);
+		return n;
 	}
 	void pop()
 	{
+		HEAPOP(pop);
 		sz--;
 		// Replace root with last child, bubble down
 		swap(0, sz);
 		// Bubble down
 		bubbledown(0);
 	}
-	void decreasekey(int a, T val)
+	void decreasekey(int a, T val) // a is a position in the heap, i.e. at[index]
 	{
 		// Update value, bubble up
+		HEAPOP(decreasekey);
 		heap[a] = val;
 		bubbleup(a);
 	}
 };
-#undef D
-#undef MAXN
\ No newline at end of file
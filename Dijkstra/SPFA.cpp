@@ -1,7 +1,6 @@
 // Shortest path faster algorithm (SPFA). Modification of Bellman-Ford, and is still worst case O(VE)
 // Is said to perform well on randomly generated graphs, based on empirical evidence alone.
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <queue>
 #include <chrono>
@@ -9,25 +8,23 @@ using namespace std;
 using namespace chrono;
 #define MAXN 1000001
 typedef long long ll;
-int v, e;
-vector<pair<int, ll> > adj[MAXN];
+#include "../Graph/csr.cpp"
+int v;
+csrgraph g; // Both directions of each edge
 deque<int> pq;
 bool onq[MAXN]; // Stores whether a node is on the queue at the moment or not
 ll dis[MAXN];
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	dis[0] = 0;
@@ -44,16 +41,18 @@ int main()
 		onq[a] = false;
 		ll d = dis[a];
 		pq.pop_front();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < dis[b.first])
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < dis[b])
 			{
-				dis[b.first] = d + b.second;
-				if (!onq[b.first]) 
+				dis[b] = d + w;
+				if (!onq[b]) 
 				{
-					if (!pq.empty() && dis[b.first] < dis[pq.front()]) pq.push_front(b.first);
-					else pq.push_back(b.first);
-					onq[b.first] = true;
+					if (!pq.empty() && dis[b] < dis[pq.front()]) pq.push_front(b);
+					else pq.push_back(b);
+					onq[b] = true;
 				}
 			}
 		}
@@ -62,7 +61,7 @@ int main()
 	printf("%lld\n", dis[v-1]);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -8,24 +8,22 @@ using namespace std;
 using namespace chrono;
 #define MAXN 1000001
 typedef long long ll;
-int v, e;
-vector<pair<int, ll> > adj[MAXN];
+#include "../Graph/csr.cpp"
+int v;
+csrgraph g; // Both directions of each edge
 priority_queue<pair<ll, int>, vector<pair<ll, int> >, greater<pair<ll, int> > > pq;
 ll dis[MAXN];
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	dis[0] = 0;
@@ -42,12 +40,14 @@ int main()
 		ll d = pq.top().first;
 		pq.pop();
 		if (dis[a] != d) continue;
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < dis[b.first])
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < dis[b])
 			{
-				dis[b.first] = d + b.second;
-				pq.emplace(dis[b.first], b.first);
+				dis[b] = d + w;
+				pq.emplace(dis[b], b);
 			}
 		}
 	}
@@ -55,7 +55,7 @@ int main()
 	printf("%lld\n", dis[v-1]);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 // Dijkstra's algorithm implemented with a binary heap: O((v + e) log v)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <queue>
 #include <chrono>
@@ -8,6 +7,7 @@ using namespace std;
 using namespace chrono;
 #define MAXN 1000001
 typedef long long ll;
+#include "../Graph/csr.cpp"
 
 struct BinaryHeap
 {
@@ -50,18 +50,14 @@ struct BinaryHeap
 	}
 	void bubbledown(int a) // Moves a value down the heap until it reaches the correct spot
 	{
-		while (2*a < upto) // Swap with the greatest of the two children
+		while (2*a < upto) // Swap with the smaller of the two children
 		{
-			if (heap[2*a] <= heap[2*a+1] && heap[2*a] < heap[a])  
+			int c = 2*a;
+			c += heap[c+1] < heap[c]; // Picks the smaller child without a branch
+			if (heap[c] < heap[a])
 			{
-				swap(a, 2*a);
-				a*=2;
-			}
-			else if (heap[2*a+1] < heap[2*a] && heap[2*a+1] < heap[a])
-			{
-				swap(a, 2*a+1);
-				a*=2;
-				a++;
+				swap(a, c);
+				a = c;
 			}
 			else break;
 		}
@@ -102,23 +98,20 @@ struct BinaryHeap
 	}
 };
 
-int v, e;
-vector<pair<int, ll> > adj[MAXN];
+int v;
+csrgraph g; // Both directions of each edge
 BinaryHeap pq;
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	pq.push(0, 0);
@@ -133,11 +126,13 @@ int main()
 		int a = pq.node[1];
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < pq.heap[pq.at[b.first]])
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < pq.heap[pq.at[b]])
 			{
-				pq.decreasekey(pq.at[b.first], d + b.second);
+				pq.decreasekey(pq.at[b], d + w);
 			}
 		}
 	}
@@ -145,7 +140,7 @@ int main()
 	printf("%lld\n", pq.heap[pq.at[v-1]]);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 // Dijkstra's algorithm implemented with a binomial heap: O((v + e) log v)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <chrono>
 using namespace std::chrono;
 typedef long long ll;
 #define MAXN 1000001
+#include "../Graph/csr.cpp"
 typedef struct BinomialNode* pnode;
 struct BinomialNode
 {
@@ -224,23 +224,20 @@ struct BinomialHeap
 		pop();
 	}
 };
-int v, e;
-std::vector<std::pair<int, ll> > adj[MAXN];
+int v;
+csrgraph g; // Both directions of each edge
 BinomialHeap pq;
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	nodes[0] = binomialheapalloc::_newnode(0);
@@ -259,11 +256,13 @@ int main()
 		int a = pq.mn->node;
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < nodes[b.first]->val)
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < nodes[b]->val)
 			{
-				pq.decreasekey(nodes[b.first], d + b.second);
+				pq.decreasekey(nodes[b], d + w);
 			}
 		}
 	}
@@ -271,7 +270,7 @@ int main()
 	printf("%lld\n", nodes[v-1]->val);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
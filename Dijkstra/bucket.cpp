@@ -0,0 +1,74 @@
+// Dijkstra's algorithm implemented with a bucket queue (Dial's algorithm): O(e + v + D), D is the largest distance
+// Compile with -DTWOLEVEL for two level buckets: O(e + v sqrt(C)), C is the largest edge weight
+// Weights of 2^24 or more always use two levels
+#include <cstdio>
+#include <utility>
+#include <queue>
+#include <chrono>
+using namespace std;
+using namespace chrono;
+#define MAXN 1000001
+typedef long long ll;
+#include "../Graph/csr.cpp"
+#include "../Bucket/bucket.cpp"
+int v;
+csrgraph g; // Both directions of each edge
+#ifdef TWOLEVEL
+typedef bucket<pair<ll, int>, freelistallocator, true> heap;
+#else
+typedef bucket<pair<ll, int> > heap;
+#endif
+BucketNode<pair<ll, int> > nodes[MAXN]; // Owned by us, so the distances can be read after they are popped
+int main()
+{
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
+	{
+		fprintf(stderr, "Malformed input\n");
+		return 1;
+	}
+	v = g.v;
+	ll C = 0; // Largest edge weight
+	for (ll j = 0; j < g.m; j++) C = max(C, g.weights[j]);
+	// Start the timer
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
+
+	heap pq(C); // Every distance in the heap is at most C more than the last one popped
+
+	// Initialise the distance to each node
+	// Nodes are only pushed once they are reached, unreached ones at 1e18 are out of range
+	nodes[0].val = make_pair(0, 0);
+	pq.push(nodes);
+	for (int i = 1; i < v; i++)
+	{
+		nodes[i].val = make_pair(1e18, i);
+	}
+
+	// Run dijkstra
+	while (!pq.empty())
+	{
+		pair<ll, int> a = pq.top();
+		pq.pop();
+		for (ll j = g.offsets[a.second]; j < g.offsets[a.second+1]; j++)
+		{
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (a.first + w < nodes[b].val.first)
+			{
+				if (nodes[b].val.first == 1e18) // First time it is reached
+				{
+					nodes[b].val.first = a.first + w;
+					pq.push(nodes+b);
+				}
+				else pq.decreasekey(nodes+b, make_pair(a.first + w, b));
+			}
+		}
+	}
+	// Print distance to node n-1;
+	printf("%lld\n", nodes[v-1].val.first);
+
+	// End the timer, print the time
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
+	ll totaltime = end.count() - start.count();
+	printf("Time % 6lldms\n", totaltime);
+}
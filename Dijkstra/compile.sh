@@ -1,4 +1,4 @@
 # Compiles the files
 echo Enter the file name
 read filename
-g++ -std=c++17 -Wl,-stack_size,0x1000000 -O2 -o $filename $filename.cpp
\ No newline at end of file
+g++ -std=c++17 -Wl,-stack_size,0x1000000 -O2 -march=native -pthread -o $filename $filename.cpp
\ No newline at end of file
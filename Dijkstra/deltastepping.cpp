@@ -0,0 +1,263 @@
+// Single source shortest paths with parallel delta-stepping (Meyer and Sanders), as a multi-core alternative to Dijkstra's algorithm with a heap
+// Vertices are kept in buckets of width delta by tentative distance, and all the vertices in the smallest bucket are relaxed at once:
+// first their light edges (weight at most delta), repeatedly, as these can put vertices back into the same bucket, then their heavy edges
+// Each vertex is owned by thread vertex % threads, which keeps it in its own bucket array and is the only one to write its distance
+// Relaxations are batched: threads send (vertex, distance) requests to the owners, which apply them after a barrier, so no atomics are needed
+// The buckets from the current one on are a cyclic array of at most maxslots, vertices in later buckets wait in an overflow heap, so a small
+// delta with large weights costs time rather than memory
+// Usage: ./deltastepping [threads] [delta] < input, as from gen.cpp or genplanar.cpp, in text or binary (see ../Graph/csr.cpp)
+// Runs Dijkstra's algorithm with a 16-ary heap as in d-ary.cpp, one of the fastest sequential heaps, then delta-stepping with 1, 2, 4, ... threads
+// up to threads (default: every core), and prints the distance to v-1, the times and the speedups. delta defaults to max weight / average degree
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+using namespace std::chrono;
+typedef long long ll;
+#include "../Graph/csr.cpp"
+#include "../D-ary/d-ary.cpp"
+struct spinbarrier // Waits until every thread has arrived, yielding so it also works with more threads than cores
+{
+	int threads;
+	std::atomic<int> waiting{0};
+	std::atomic<int> phase{0};
+	spinbarrier(int n) : threads(n)
+	{
+	}
+	void wait()
+	{
+		int p = phase.load(std::memory_order_relaxed); // Cannot change until this thread has arrived
+		if (waiting.fetch_add(1, std::memory_order_acq_rel) == threads-1)
+		{
+			waiting.store(0, std::memory_order_relaxed);
+			phase.fetch_add(1, std::memory_order_release);
+		}
+		else while (phase.load(std::memory_order_acquire) == p) std::this_thread::yield();
+	}
+};
+struct deltastepping
+{
+	struct worker
+	{
+		std::vector<std::vector<int> > buckets; // Cyclic, bucket i is buckets[i % slots]
+		// (bucket, vertex) for the vertices queued past the cyclic array. Entries are stale once the vertex has moved
+		std::priority_queue<std::pair<ll, int>, std::vector<std::pair<ll, int> >, std::greater<std::pair<ll, int> > > far;
+		ll queued; // Entries in the cyclic array, stale ones included, so that it is not scanned when empty
+		std::vector<int> settled; // Vertices taken from the current bucket, their heavy edges are relaxed once it stays empty
+		std::vector<std::vector<std::pair<int, ll> > > out; // Requests to each thread
+		ll next; // Smallest nonempty bucket, LLONG_MAX if none
+		bool more; // Whether the current bucket is nonempty
+		char padding[64]; // Keeps the flags of different threads on different cache lines
+	};
+	const csrgraph &g;
+	int threads;
+	ll delta;
+	static const int maxslots = 1 << 16;
+	int slots; // Buckets current to current + slots - 1 are in the cyclic arrays, enough for maxweight past the current bucket if at most maxslots
+	ll* dist;
+	ll* where; // Bucket a vertex is queued in, -1 if none. Entries in other buckets are stale
+	std::vector<worker> workers;
+	spinbarrier barrier;
+	deltastepping(const csrgraph &_g, int t, ll d, ll maxweight) : g(_g), threads(t), delta(d), barrier(t)
+	{
+		slots = std::min(maxweight/delta + 2, (ll)maxslots);
+		dist = new ll[g.v];
+		where = new ll[g.v];
+		workers.resize(threads);
+		for (worker &w : workers)
+		{
+			w.buckets.resize(slots);
+			w.queued = 0;
+			w.out.resize(threads);
+		}
+	}
+	~deltastepping()
+	{
+		delete[] dist;
+		delete[] where;
+	}
+	void queue(worker &w, ll i, int a) // Puts a in bucket i of the cyclic array
+	{
+		w.buckets[i % slots].push_back(a);
+		w.queued++;
+	}
+	void request(worker &w, int b, ll d)
+	{
+		if (d < dist[b]) w.out[b % threads].emplace_back(b, d); // Only owners write distances, and not in this phase
+	}
+	void apply(int id, ll current) // Applies the requests sent to this thread, while relaxing bucket current
+	{
+		worker &w = workers[id];
+		for (worker &from : workers)
+		{
+			for (const std::pair<int, ll> &r : from.out[id])
+			{
+				int b = r.first;
+				if (r.second >= dist[b]) continue;
+				dist[b] = r.second;
+				ll i = r.second / delta;
+				if (where[b] != i)
+				{
+					where[b] = i;
+					if (i < current + slots) queue(w, i, b);
+					else w.far.emplace(i, b);
+				}
+			}
+			from.out[id].clear();
+		}
+	}
+	ll smallest(worker &w, ll from) // Smallest nonempty bucket of w from from, or the first bucket in far if smaller
+	{
+		ll farmin = w.far.empty() ? LLONG_MAX : w.far.top().first;
+		for (ll i = from; w.queued && i < from + slots && i < farmin; i++)
+		{
+			std::vector<int> &bucket = w.buckets[i % slots];
+			for (int a : bucket) if (where[a] == i) return i;
+			w.queued -= bucket.size(); // Only stale entries, drop them
+			bucket.clear();
+		}
+		return farmin;
+	}
+	void pullfar(worker &w, ll current) // Moves the vertices of far whose buckets are now in the cyclic array into it
+	{
+		while (!w.far.empty() && w.far.top().first < current + slots)
+		{
+			std::pair<ll, int> x = w.far.top();
+			w.far.pop();
+			if (where[x.second] == x.first) queue(w, x.first, x.second);
+		}
+	}
+	void work(int id)
+	{
+		worker &w = workers[id];
+		for (int a = id; a < g.v; a += threads)
+		{
+			dist[a] = 1e18;
+			where[a] = -1;
+		}
+		if (!id)
+		{
+			dist[0] = 0;
+			where[0] = 0;
+			queue(w, 0, 0);
+		}
+		ll current = 0;
+		std::vector<int> frontier;
+		while (true)
+		{
+			w.next = smallest(w, current);
+			barrier.wait();
+			current = LLONG_MAX;
+			for (worker &x : workers) current = std::min(current, x.next);
+			if (current == LLONG_MAX) break;
+			pullfar(w, current);
+			std::vector<int> &bucket = w.buckets[current % slots];
+			while (true) // Light edges, until the bucket stays empty
+			{
+				for (int a : bucket)
+				{
+					if (where[a] != current) continue; // Moved to a smaller bucket
+					where[a] = -1;
+					frontier.push_back(a);
+					w.settled.push_back(a);
+				}
+				w.queued -= bucket.size();
+				bucket.clear();
+				for (int a : frontier)
+				{
+					for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++) if (g.weights[j] <= delta) request(w, g.targets[j], dist[a] + g.weights[j]);
+				}
+				frontier.clear();
+				barrier.wait();
+				apply(id, current);
+				w.more = !bucket.empty();
+				barrier.wait();
+				bool more = false;
+				for (worker &x : workers) more |= x.more;
+				if (!more) break;
+			}
+			for (int a : w.settled) // Heavy edges, which cannot lead back into this bucket
+			{
+				for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++) if (g.weights[j] > delta) request(w, g.targets[j], dist[a] + g.weights[j]);
+			}
+			w.settled.clear();
+			barrier.wait();
+			apply(id, current);
+		}
+	}
+	void run()
+	{
+		std::vector<std::thread> pool;
+		for (int i = 1; i < threads; i++) pool.emplace_back(&deltastepping::work, this, i);
+		work(0);
+		for (std::thread &t : pool) t.join();
+	}
+};
+double elapsed(steady_clock::time_point start) // In milliseconds
+{
+	return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+int main(int argc, char** argv)
+{
+	int maxthreads = argc > 1 ? atoi(argv[1]) : std::thread::hardware_concurrency();
+	if (maxthreads < 1) maxthreads = 1;
+	csrgraph g;
+	if (!g.read(stdin, true))
+	{
+		fprintf(stderr, "Malformed input\n");
+		return 1;
+	}
+	int v = g.v;
+	ll maxweight = 1;
+	for (ll j = 0; j < g.m; j++) maxweight = std::max(maxweight, g.weights[j]);
+	ll delta = argc > 2 ? atoll(argv[2]) : std::max(1ll, (ll)(maxweight / std::max(1.0, (double)g.m / v)));
+	if (delta < 1) delta = 1;
+
+	// Sequential baseline, as in d-ary.cpp
+	steady_clock::time_point start = steady_clock::now();
+	ll* dist = new ll[v];
+	{
+		dary<ll, 16> pq;
+		pq.reserve(v);
+		pq.push(0);
+		for (int i = 1; i < v; i++) pq.push(1e18);
+		while (!pq.empty())
+		{
+			int a = pq.node[0];
+			ll d = pq.top();
+			pq.pop();
+			dist[a] = d;
+			for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
+			{
+				int b = g.targets[j];
+				if (d + g.weights[j] < pq.heap[pq.at[b]]) pq.decreasekey(pq.at[b], d + g.weights[j]);
+			}
+		}
+	}
+	double sequential = elapsed(start);
+	printf("%lld\n", dist[v-1]);
+	printf("delta %lld\n", delta);
+	printf("%-24s %10s %8s\n", "", "time(ms)", "speedup");
+	printf("%-24s %10.1f %8.2f\n", "dijkstra 16-ary heap", sequential, 1.0);
+	for (int threads = 1; ; threads = std::min(2*threads, maxthreads))
+	{
+		deltastepping ds(g, threads, delta, maxweight);
+		start = steady_clock::now();
+		ds.run();
+		double time = elapsed(start);
+		bool same = true;
+		for (int i = 0; i < v; i++) same &= ds.dist[i] == dist[i];
+		char name[32];
+		snprintf(name, sizeof(name), "delta-stepping %d", threads);
+		printf("%-24s %10.1f %8.2f%s\n", name, time, sequential / time, same ? "" : " (distances differ)");
+		fflush(stdout);
+		if (threads == maxthreads) break;
+	}
+}
@@ -6,6 +6,8 @@ using namespace std;
 typedef long long ll;
 // Generates n points in a plane, then a random graph. Specifially, generates k*multiplier outgoing edges from each node
 // Then takes the k closest. This is to resemble real-life representations where edges generally exist between closer locations
+// Usage: echo "v k [seed]" | ./genplanar [coordinates file]
+// If a file is given, the coordinates are written to it: v, then the x and y of each vertex on a line (for A* in Benchmark/astar.cpp)
 ll x[MAXN], y[MAXN];
 int v, k;
 vector<pair<pair<int, int>, ll> > edges;
@@ -13,15 +15,30 @@ ll dis(int a, int b) // Euclidian distance
 {
 	return sqrt((x[a]-x[b])*(x[a]-x[b]) + (y[a]-y[b])*(y[a]-y[b]));
 }
-int main()
+int main(int argc, char** argv)
 {
-	srand(time(NULL));
 	scanf("%d%d", &v, &k);
+	unsigned int seed = time(NULL); // An optional seed can follow, so the same input can be generated again
+	scanf("%u", &seed);
+	srand(seed);
+	fprintf(stderr, "Seed %u\n", seed);
 	for (int i = 0; i < v; i++)
 	{
 		x[i] = rand()%MXCOORD;
 		y[i] = rand()%MXCOORD;
 	}
+	if (argc > 1)
+	{
+		FILE* f = fopen(argv[1], "w");
+		if (!f)
+		{
+			fprintf(stderr, "Cannot write %s\n", argv[1]);
+			return 1;
+		}
+		fprintf(f, "%d\n", v);
+		for (int i = 0; i < v; i++) fprintf(f, "%lld %lld\n", x[i], y[i]);
+		fclose(f);
+	}
 	for (int i = 0; i < v; i++)
 	{
 		vector<pair<ll, int> > currentedges;
@@ -1,6 +1,5 @@
 // Dijkstra's algorithm implemented with a hollow heap: O(e + vloge)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <chrono>
 #define MAXn 1000000 // Maximum number of items (push)
@@ -9,6 +8,7 @@ using namespace std::chrono;
 typedef struct Item* pitem;
 typedef struct Node* pnode;
 typedef long long ll;
+#include "../Graph/csr.cpp"
 struct Item // The actual items in the heap
 {
 	pnode inheap;
@@ -221,24 +221,21 @@ struct HollowHeap
 		}
 	}
 };
-int v, e;
-std::vector<std::pair<int, ll> > adj[MAXn];
+int v;
+csrgraph g; // Both directions of each edge
 HollowHeap pq;
 pitem nodes[MAXn];
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	nodes[0] = newitem();
@@ -257,11 +254,13 @@ int main()
 		int a = pq.root->item->node;
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < nodes[b.first]->inheap->val)
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < nodes[b]->inheap->val)
 			{
-				pq.decreasekey(nodes[b.first], d + b.second);
+				pq.decreasekey(nodes[b], d + w);
 			}
 		}
 	}
@@ -269,7 +268,7 @@ int main()
 	printf("%lld\n", nodes[v-1]->inheap->val);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 // Dijkstra's algorithm implemented with a naive O(n) heap: O(n^2 + e)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <chrono>
 using namespace std::chrono;
 #define MAXN 1000001
 typedef long long ll;
+#include "../Graph/csr.cpp"
 struct NaiveHeap
 {
 	ll heap[MAXN];
@@ -71,22 +71,19 @@ struct NaiveHeap
 	}
 };
 NaiveHeap pq;
-int v, e;
-std::vector<std::pair<int, ll> > adj[MAXN];
+int v;
+csrgraph g; // Both directions of each edge
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	pq.push(0);
@@ -101,11 +98,13 @@ int main()
 		int a = pq.mnloc;
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < pq.heap[b.first])
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < pq.heap[b])
 			{
-				pq.decreasekey(b.first, d + b.second);
+				pq.decreasekey(b, d + w);
 			}
 		}
 	}
@@ -113,7 +112,7 @@ int main()
 	printf("%lld\n", pq.heap[v-1]);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 // Dijkstra's algorithm implemented with a pairing heap: O((e + v)log v)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <chrono>
 using namespace std::chrono;
 #define MAXN 1000001
 typedef long long ll;
+#include "../Graph/csr.cpp"
 typedef struct PairingNode* pnode;
 struct PairingNode
 {
@@ -94,18 +94,38 @@ struct PairingHeap
 		pnode _new = pairingheapalloc::newnode(val);
 		push(_new);
 	}
-	pnode recursivemerge(pnode a) // Helps with the pop function. First merges pairs of trees, then merges the pairs into one tree
-	{
-		if (!a) return a;
-		pnode b = a->right;
-		if (!b) return a;
-		pnode c = b->right;
-		return merge(merge(a, b), recursivemerge(c));
+	pnode twopass(pnode a) // Helps with the pop function. First merges pairs of trees, then merges the pairs into one tree
+	{	// Iterative, so the stack does not overflow when the root has millions of children
+		pnode pairs = NULL; // Stack of merged pairs, linked through right
+		while (a)
+		{
+			pnode b = a->right;
+			if (!b) // Odd tree out, it is the rightmost 'pair'
+			{
+				a->right = pairs;
+				pairs = a;
+				break;
+			}
+			pnode c = b->right;
+			a = merge(a, b);
+			a->right = pairs;
+			pairs = a;
+			a = c;
+		}
+		// Merge the pairs from right to left
+		a = NULL;
+		while (pairs)
+		{
+			pnode b = pairs->right;
+			a = merge(pairs, a);
+			pairs = b;
+		}
+		return a;
 	}
 	void pop() // Removes the smallest element from the heap
 	{
 		sz--;
-		root = recursivemerge(root->child);
+		root = twopass(root->child);
 		if (root) root->right = NULL;
 	}
 	void decreasekey(pnode a, ll val)
@@ -128,24 +148,21 @@ struct PairingHeap
 		}
 	}
 };
-int v, e;
-std::vector<std::pair<int, ll> > adj[MAXN];
+int v;
+csrgraph g; // Both directions of each edge
 PairingHeap pq;
 pnode nodes[MAXN];
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	nodes[0] = pairingheapalloc::newnode(0);
@@ -164,11 +181,13 @@ int main()
 		int a = pq.root->node;
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < nodes[b.first]->val)
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < nodes[b]->val)
 			{
-				pq.decreasekey(nodes[b.first], d + b.second);
+				pq.decreasekey(nodes[b], d + w);
 			}
 		}
 	}
@@ -176,7 +195,7 @@ int main()
 	printf("%lld\n", nodes[v-1]->val);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 // Dijkstra's algorithm implemented with a quake heap: O(e + vlogv)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <chrono>
 using namespace std::chrono;
@@ -11,6 +10,7 @@ using namespace std::chrono;
 typedef struct QuakeValue* pvalue;
 typedef struct QuakeNode* pnode;
 typedef long long ll;
+#include "../Graph/csr.cpp"
 struct QuakeValue
 {
 	pnode inheap; // Highest occurrence of it in the heap
@@ -278,24 +278,21 @@ struct QuakeHeap
 		else if (val < root->val->val) root = x; // Update root if needed
 	}
 };
-int v, e;
-std::vector<std::pair<int, ll> > adj[MAXN];
+int v;
+csrgraph g; // Both directions of each edge
 QuakeHeap pq;
 pvalue nodes[MAXN];
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	nodes[0] = newvaluenode(0);
@@ -314,11 +311,13 @@ int main()
 		int a = pq.root->val->node;
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < nodes[b.first]->val)
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < nodes[b]->val)
 			{
-				pq.decreasekey(nodes[b.first], d + b.second);
+				pq.decreasekey(nodes[b], d + w);
 			}
 		}
 	}
@@ -326,7 +325,7 @@ int main()
 	printf("%lld\n", nodes[v-1]->val);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Dijkstra's algorithm implemented with a radix heap: O(e + v log C), C is the largest distance
+#include <cstdio>
+#include <utility>
+#include <queue>
+#include <chrono>
+using namespace std;
+using namespace chrono;
+#define MAXN 1000001
+typedef long long ll;
+#include "../Graph/csr.cpp"
+#include "../Radix/radix.cpp"
+int v;
+csrgraph g; // Both directions of each edge
+radixdk<pair<ll, int> > pq; // Key is the distance, the bucket only looks at the first element
+RadixNode<pair<ll, int> > nodes[MAXN]; // Owned by us, so the distances can be read after they are popped
+int main()
+{
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
+	{
+		fprintf(stderr, "Malformed input\n");
+		return 1;
+	}
+	v = g.v;
+	// Start the timer
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
+
+	// Initialise the distance to each node
+	// Nodes are only pushed once they are reached, unreached ones would all share the top bucket and be rescanned on every pop
+	nodes[0].val = make_pair(0, 0);
+	pq.push(nodes);
+	for (int i = 1; i < v; i++)
+	{
+		nodes[i].val = make_pair(1e18, i);
+	}
+
+	// Run dijkstra
+	while (!pq.empty())
+	{
+		pair<ll, int> a = pq.top();
+		pq.pop();
+		for (ll j = g.offsets[a.second]; j < g.offsets[a.second+1]; j++)
+		{
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (a.first + w < nodes[b].val.first)
+			{
+				if (nodes[b].val.first == 1e18) // First time it is reached
+				{
+					nodes[b].val.first = a.first + w;
+					pq.push(nodes+b);
+				}
+				else pq.decreasekey(nodes+b, make_pair(a.first + w, b));
+			}
+		}
+	}
+	// Print distance to node n-1;
+	printf("%lld\n", nodes[v-1].val.first);
+
+	// End the timer, print the time
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
+	ll totaltime = end.count() - start.count();
+	printf("Time % 6lldms\n", totaltime);
+}
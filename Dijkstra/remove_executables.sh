@@ -12,8 +12,12 @@ rm quake
 rm violation
 rm strictfibonacci
 rm d-ary
+rm d-ary-scalar
+rm radix
+rm bucket
 rm SPFA
 rm STL
+rm deltastepping
 rm gen
 rm in.txt
 rm in
@@ -1,11 +1,11 @@
 // Dijkstra's algorithm implemented with a strict fibonacci heap: O(e + vlogv)
 #include <cstdio>
-#include <vector>
 #include <utility>
 #include <chrono>
 using namespace std::chrono;
 #define MAXN 1000001
 typedef long long ll;
+#include "../Graph/csr.cpp"
 typedef struct HeapNode* pnode;
 typedef struct ActiveRecord* pactivenode;
 typedef struct RanklistNode* pranklist;
@@ -889,24 +889,21 @@ struct StrictFibonacciHeap // The actual heap
 		}
 	}
 };
-int v, e;
-std::vector<std::pair<int, ll> > adj[MAXN];
+int v;
+csrgraph g; // Both directions of each edge
 StrictFibonacciHeap pq;
 pvalue nodes[MAXN];
 int main()
 {
-	// Scan in the input
-	scanf("%d%d", &v, &e);
-	for (int i = 0; i < e; i++)
+	// Read the graph, in the text or binary format (see ../Graph/csr.cpp)
+	if (!g.read(stdin, true))
 	{
-		int a, b;
-		ll c;
-		scanf("%d%d%lld", &a, &b, &c);
-		adj[a].emplace_back(b, c);
-		adj[b].emplace_back(a, c);
+		fprintf(stderr, "Malformed input\n");
+		return 1;
 	}
+	v = g.v;
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	// Initialise the distance to each node
 	for (int i = 0; i < v; i++) nodes[i] = newValueNode(); // Allocate memory
@@ -924,11 +921,13 @@ int main()
 		int a = pq.root->val->val.second;
 		ll d = pq.top();
 		pq.pop();
-		for (auto b : adj[a])
+		for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
 		{
-			if (d + b.second < nodes[b.first]->val.first)
+			int b = g.targets[j];
+			ll w = g.weights[j];
+			if (d + w < nodes[b]->val.first)
 			{
-				pq.decreasekey(nodes[b.first]->inheap, d + b.second);
+				pq.decreasekey(nodes[b]->inheap, d + w);
 			}
 		}
 	}
@@ -936,7 +935,7 @@ int main()
 	printf("%lld\n", nodes[v-1]->val.first);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -8,9 +8,12 @@ vector<pair<pair<int, int>, ll > > edges;
 ll dis[100000];
 int main()
 {
-	srand(time(NULL));
 	scanf("%d", &n);
 	scanf("%d", &r);
+	unsigned int seed = time(NULL); // An optional seed can follow, so the same input can be generated again
+	scanf("%u", &seed);
+	srand(seed);
+	fprintf(stderr, "Seed %u\n", seed);
 	for (int i = 1; i < n; i++)
 	{
 		dis[i] = 1e12-i;
@@ -9,8 +9,11 @@ ll dis[100000];
 ll lowest = 1e13;
 int main()
 {
-	srand(time(NULL));
 	scanf("%d%d", &v, &e); // E is the number of outgoing edges per node
+	unsigned int seed = time(NULL); // An optional seed can follow, so the same input can be generated again
+	scanf("%u", &seed);
+	srand(seed);
+	fprintf(stderr, "Seed %u\n", seed);
 	for (int i = 1; i < v; i++)
 	{
 		dis[i] = 1e13;
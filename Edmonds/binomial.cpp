@@ -316,7 +316,7 @@ int main()
 	}
 
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	for (int i = 0; i < e; i++) // Push onto heaps
 	{
@@ -328,7 +328,7 @@ int main()
 		roots.push(i);
 	}
 	// Print time taken to push
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time taken to push % 6lldms\n", totaltime);
 	// Run the algorithm
@@ -384,7 +384,7 @@ int main()
 	printf("%lld\n", ans);
 
 	// End the timer, print the time
-	end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
@@ -9,9 +9,12 @@ vector<pair<pair<int, int>, ll> > edges;
 int reorder[1000010];
 int main()
 {
-	srand(time(NULL));
 	int v, e;
 	scanf("%d%d", &v, &e);
+	unsigned int seed = time(NULL); // An optional seed can follow, so the same input can be generated again
+	scanf("%u", &seed);
+	srand(seed);
+	fprintf(stderr, "Seed %u\n", seed);
 	printf("%d %d\n", v, e);
 	e-=v-1;
 	assert(e >= 0);
@@ -37,8 +40,7 @@ int main()
 	{
 		reorder[i] = i;
 	}
-	random_device rd;
-    mt19937 g(rd());
+    mt19937 g(seed);
 	shuffle(edges.begin(), edges.end(), g);
 	shuffle(reorder+1, reorder+v, g);
 	for (auto a : edges)
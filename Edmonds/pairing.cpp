@@ -179,18 +179,38 @@ struct PairingHeap
 		pnode _new = pairingheapalloc::newnode(val);
 		push(_new);
 	}
-	pnode recursivemerge(pnode a) // Helps with the pop function. First merges pairs of trees, then merges the pairs into one tree
-	{
-		if (!a) return a;
-		pnode b = a->right;
-		if (!b) return a;
-		pnode c = b->right;
-		return merge(merge(a, b), recursivemerge(c));
+	pnode twopass(pnode a) // Helps with the pop function. First merges pairs of trees, then merges the pairs into one tree
+	{	// Iterative, so the stack does not overflow when the root has millions of children
+		pnode pairs = NULL; // Stack of merged pairs, linked through right
+		while (a)
+		{
+			pnode b = a->right;
+			if (!b) // Odd tree out, it is the rightmost 'pair'
+			{
+				a->right = pairs;
+				pairs = a;
+				break;
+			}
+			pnode c = b->right;
+			a = merge(a, b);
+			a->right = pairs;
+			pairs = a;
+			a = c;
+		}
+		// Merge the pairs from right to left
+		a = NULL;
+		while (pairs)
+		{
+			pnode b = pairs->right;
+			a = merge(pairs, a);
+			pairs = b;
+		}
+		return a;
 	}
 	void pop() // Removes the largest element from the heap
 	{
 		sz--;
-		root = recursivemerge(root->child);
+		root = twopass(root->child);
 		if (root) root->right = NULL;
 	}
 };
@@ -222,7 +242,7 @@ int main()
 	}
 
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	for (int i = 0; i < e; i++) // Push onto heaps
 	{
@@ -234,7 +254,7 @@ int main()
 		roots.push(i);
 	}
 	// Print time taken to push
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time taken to push % 6lldms\n", totaltime);
 	// Run the algorithm
@@ -290,7 +310,7 @@ int main()
 	printf("%lld\n", ans);
 
 	// End the timer, print the time
-	end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
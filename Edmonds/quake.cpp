@@ -380,14 +380,14 @@ int main()
 	}
 
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 
 	for (int i = 0; i < e; i++) // Push onto heaps
 	{
 		incoming[edges[i].v]->push(edges[i]);
 	}
 	// Print time taken to push
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time taken to push % 6lldms\n", totaltime);
 	// Push all nodes onto the queue to be processed, except the root
@@ -448,7 +448,7 @@ int main()
 	printf("%lld\n", ans);
 
 	// End the timer, print the time
-	end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
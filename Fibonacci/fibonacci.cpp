@@ -1,4 +1,6 @@
 #include <algorithm>
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 // Fibonacci Heap with push, pop, erase, top (minimum), merge & decrease key
 template<class T> struct FibonacciNode
 {
@@ -6,24 +8,26 @@ template<class T> struct FibonacciNode
 	T val;
 	int degree; // Value of the node and number of children
 	bool onechildcut; // Whether one of its children has been cut due to decrease key
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 	pnode left, right, child, par; // When the node is the root of the heap, left and right refer to its neighbours in the heap linked list
 	// When the node is not the root of the heap, left and right refer to its neighbouring siblings
 };
 // Global variables, used for intermediate storage during the pop function
 
-template<class T> FibonacciNode<T>* _fibonaccinewnode(T val)
+template<class T, class A> FibonacciNode<T>* _fibonaccinewnode(A &alloc, T val)
 {
 	typedef struct FibonacciNode<T>* pnode;
-	pnode _new = new FibonacciNode<T>();
+	pnode _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
 
-template<class T> struct fibonacci
+template<class T, template<class> class Alloc = freelistallocator> struct fibonacci
 {
 	typedef struct FibonacciNode<T>* pnode;
+	Alloc<FibonacciNode<T> > alloc; // Allocates the nodes of this heap
 	pnode _ofsize[50];
-	int _ofsizedone[50], _ofsizeupto;
+	int _ofsizedone[50], _ofsizeupto = 0;
 	fibonacci()
 	{
 		std::fill_n(_ofsizedone, 50, 0);
@@ -31,6 +35,7 @@ template<class T> struct fibonacci
 	pnode mn = 0; // Pointer to the maximum value in the heap
 	int sz = 0; // Number of elements in the heap
 	pnode temproot = 0; // Used in the pop function
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Auxiliary functions
 	int size()
 	{
@@ -50,6 +55,10 @@ template<class T> struct fibonacci
 		a = b;
 		b = c;
 	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
 	pnode mergetrees(pnode a, pnode b) // Merges trees with equal degree, creating one tree with degree+1
 	{
 		if (b->val < a->val)
@@ -66,6 +75,7 @@ template<class T> struct fibonacci
 			}
 		}
 		// Make tree b the child of tree a
+		HEAPLINK();
 		a->degree++;
 		b->right = a->child;
 		if (b->right) b->right->left = b;
@@ -89,7 +99,7 @@ template<class T> struct fibonacci
 	}
 
 	// Main functions
-	void push(pnode _new) // Insert a node into the heap
+	void insert(pnode _new) // Insert a node into the heap
 	{
 		if (!sz)
 		{
@@ -103,19 +113,32 @@ template<class T> struct fibonacci
 		sz++;
 		addintoheap(_new);
 	}
-	pnode push(T val) // Insert a value into the heap
+	void push(pnode _new) // Insert a node owned by the caller into the heap
 	{
-		pnode _new = _fibonaccinewnode(val);
-		push(_new);
+		HEAPOP(push);
+		HEAPTOUCH(1);
+		_new->callerowned = true;
+		insert(_new);
+	}
+	pnode push(T val) // Insert a value into the heap. The returned node is valid until the value is popped
+	{
+		HEAPOP(push);
+		HEAPTOUCH(1);
+		pnode _new = _fibonaccinewnode<T>(alloc, val);
+		insert(_new);
 		return _new;
 	}
 
 	void pop() // Remove the smallest element from the heap
 	{
+		HEAPOP(pop);
+		HEAPTOUCH(1);
 		sz--;
+		pnode old = mn; // Recycled once it is no longer referenced
 		if (!sz) // If only one element, just remove it
 		{
 			mn = 0;
+			reclaim(old);
 			return;
 		}
 		// Remove mn from the heap
@@ -130,11 +153,13 @@ template<class T> struct fibonacci
 			while (child != 0)
 			{
 				pnode nextchild = child->right;
+				HEAPTOUCH(1);
 				addintoheap(child);
 				if (child->val < mn->val) mn = child;
 				child = nextchild;
 			}
 			// The heap is now sufficient (since there were at most log children)
+			reclaim(old);
 			return;
 		}
 		else
@@ -148,6 +173,7 @@ template<class T> struct fibonacci
 			while (child != 0)
 			{
 				pnode nextchild = child->right; // Store the next child because it will be lost when we insert child into the heap
+				HEAPTOUCH(1);
 				// Insert child into heap
 				child->right = temproot->right;
 				child->left = temproot;
@@ -178,17 +204,22 @@ template<class T> struct fibonacci
 				// merge a & b
 				a = mergetrees(a, b);
 			}
+			HEAPTOUCH(1);
 			_ofsizedone[a->degree] = _ofsizeupto;
 			_ofsize[a->degree] = a;
 			if (mn->val >= a->val) mn = a;
 			a = a->right;
 		}
 		while (a != temproot);
+		reclaim(old);
 	}
-	void merge(fibonacci<T> *a) // Merge Fibonacci Heap a into this heap
+	void merge(fibonacci *a) // Merge Fibonacci Heap a into this heap
 	{
+		HEAPOP(merge);
 		// Cut each heap between their maximum and the element to the right of that, then splice together
 		sz += a->sz; // update size of heap
+		alloc.merge(a->alloc); // Nodes of a are now owned by this heap
+		ownshandles = ownshandles && a->ownshandles; // Nodes of a stay valid after pop if a kept them
 		if (!mn)
 		{
 			mn = a->mn;
@@ -216,6 +247,7 @@ template<class T> struct fibonacci
 			a->degree--;
 		}
 		if (p == 0) return;
+		HEAPCUT();
 		if (p->child == a) // A is the first child of p
 		{
 			p->child = a->right;
@@ -230,26 +262,29 @@ template<class T> struct fibonacci
 		// insert a into the heap linked list
 		addintoheap(a);
 	}
+	void cut(pnode a) // Cuts a from its parent into the heap linked list, then the marked ancestors, and marks the first unmarked one
+	{
+		pnode p = a->par;
+		cutfromtree(a); // Cut a from the tree
+		while (p && p->onechildcut) // If any parents are marked, cut from tree
+		{
+			p->degree--; // P has lost a child, subtract one from the degree
+			pnode _newpar = p->par;
+			cutfromtree(p);
+			p = _newpar;
+		}
+		if (p)
+		{
+			p->onechildcut = 1; // Mark the parent
+		}
+	}
 	void decreasekey(pnode a, T val) // Decrease the value of a node. If val > a->val the heap-order will be broken
 	{
 		// Update the value of a
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
-		if (a->par != 0 && a->par->val > a->val) // heap order has been violated
-		{
-			pnode p = a->par;
-			cutfromtree(a); // Cut a from the tree
-			while (p && p->onechildcut) // If any parents are marked, cut from tree
-			{
-				p->degree--; // P has lost a child, subtract one from the degree
-				pnode _newpar = p->par;
-				cutfromtree(p);
-				p = _newpar;
-			}
-			if (p)
-			{
-				p->onechildcut = 1; // Mark the parent
-			}
-		}
+		if (a->par != 0 && a->par->val > a->val) cut(a); // heap order has been violated
 		else // Update max if needed
 		{
 			if (a->val < mn->val) mn = a;
@@ -257,9 +292,9 @@ template<class T> struct fibonacci
 	}
 	void erase(pnode a) // Remove a node from the heap
 	{
-		// Update the value to infinity (in this case, (2^31)-1)
-		decreasekey(a, (1ll << 31)-1);
-		// Since a should now be the greatest element, pop
+		// Make a a root and pop it as if it was the minimum, pop finds the real minimum again without comparing with a
+		if (a->par) cut(a);
+		mn = a;
 		pop();
 	}
 };
@@ -0,0 +1,260 @@
+// Graphs in compressed sparse row form: the edges out of vertex a are at indices offsets[a] to offsets[a+1]-1 of targets and weights
+// A graph is read from the text format of the generators ("v e" then e lines of "a b weight"), or mapped from a binary file written by
+// write() (Benchmark/tocsr.cpp converts text to it), without copying or parsing: loading then costs only the page faults of what is read
+// Binary format, native byte order:
+//   "HEAPCSR1", then v, e, m (the number of entries in targets and weights) and flags as 64-bit integers
+//   offsets: v+1 64-bit integers, targets: m 32-bit integers padded to a multiple of 8 bytes, weights: m 64-bit integers
+// If the graph is symmetric (flags bit 0), every edge is stored in both directions, so m = 2e, as Dijkstra and Stoer-Wagner use them
+// Otherwise every edge is stored once, out of its first vertex, so m = e
+#ifndef HEAPS_CSR_H
+#define HEAPS_CSR_H
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+typedef long long ll;
+struct csrgraph
+{
+	int v = 0;
+	ll e = 0; // Edges in the input
+	ll m = 0; // Entries, e or 2e
+	bool symmetric = false;
+	const ll* offsets = nullptr;
+	const int* targets = nullptr;
+	const ll* weights = nullptr;
+	void* mapped = nullptr; // The file, if mapped, otherwise the arrays are owned
+	size_t mappedsize = 0;
+	csrgraph()
+	{
+	}
+	csrgraph(const csrgraph&) = delete; // Owns its arrays or its mapping
+	csrgraph& operator=(const csrgraph&) = delete;
+	~csrgraph()
+	{
+		clear();
+	}
+	void clear()
+	{
+		if (mapped) munmap(mapped, mappedsize);
+		else
+		{
+			delete[] offsets;
+			delete[] targets;
+			delete[] weights;
+		}
+		mapped = nullptr;
+		offsets = weights = nullptr;
+		targets = nullptr;
+		v = 0;
+		e = m = 0;
+	}
+	static size_t _targetbytes(ll m) // Padded, so the weights are aligned
+	{
+		return (4*m + 7)/8*8;
+	}
+	void build(int _v, ll _e, const int* from, const int* to, const ll* weight, bool _symmetric) // From an edge list, keeping the order of each vertex's edges
+	{
+		clear();
+		v = _v;
+		e = _e;
+		symmetric = _symmetric;
+		m = symmetric ? 2*e : e;
+		ll* o = new ll[v+1]();
+		int* t = new int[m];
+		ll* w = new ll[m];
+		for (ll i = 0; i < e; i++)
+		{
+			o[from[i]+1]++;
+			if (symmetric) o[to[i]+1]++;
+		}
+		for (int a = 0; a < v; a++) o[a+1] += o[a];
+		ll* at = new ll[v]; // Next free entry of each vertex
+		for (int a = 0; a < v; a++) at[a] = o[a];
+		for (ll i = 0; i < e; i++)
+		{
+			ll j = at[from[i]]++;
+			t[j] = to[i];
+			w[j] = weight[i];
+			if (symmetric)
+			{
+				j = at[to[i]]++;
+				t[j] = from[i];
+				w[j] = weight[i];
+			}
+		}
+		delete[] at;
+		offsets = o;
+		targets = t;
+		weights = w;
+	}
+	void symmetrise(const csrgraph &g) // Builds g with every edge in both directions, g if it already is
+	{
+		clear();
+		v = g.v;
+		e = g.e;
+		symmetric = true;
+		m = g.symmetric ? g.m : 2*g.m;
+		ll* o = new ll[v+1]();
+		int* t = new int[m];
+		ll* w = new ll[m];
+		for (int a = 0; a < v; a++)
+		{
+			o[a+1] += g.offsets[a+1] - g.offsets[a];
+			if (!g.symmetric) for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++) o[g.targets[j]+1]++;
+		}
+		for (int a = 0; a < v; a++) o[a+1] += o[a];
+		ll* at = new ll[v];
+		for (int a = 0; a < v; a++) at[a] = o[a];
+		for (int a = 0; a < v; a++)
+		{
+			for (ll j = g.offsets[a]; j < g.offsets[a+1]; j++)
+			{
+				ll k = at[a]++;
+				t[k] = g.targets[j];
+				w[k] = g.weights[j];
+				if (!g.symmetric)
+				{
+					k = at[g.targets[j]]++;
+					t[k] = a;
+					w[k] = g.weights[j];
+				}
+			}
+		}
+		delete[] at;
+		offsets = o;
+		targets = t;
+		weights = w;
+	}
+	bool readtext(FILE* in, bool _symmetric) // Reads the text format. Returns false if it is malformed
+	{
+		char buffer[1 << 16];
+		size_t n = 0, at = 0;
+		bool ok = true;
+		auto get = [&]() -> ll // Next integer, read a buffer at a time, as scanf takes far longer than the rest of loading
+		{
+			auto next = [&]() -> int
+			{
+				if (at == n)
+				{
+					n = fread(buffer, 1, sizeof(buffer), in);
+					at = 0;
+					if (!n) return -1;
+				}
+				return (unsigned char)buffer[at++];
+			};
+			int c = next();
+			while (c == ' ' || c == '\n' || c == '\r' || c == '\t') c = next();
+			bool negative = c == '-';
+			if (negative) c = next();
+			if (c < '0' || c > '9')
+			{
+				ok = false;
+				return 0;
+			}
+			ll a = 0;
+			while (c >= '0' && c <= '9')
+			{
+				a = 10*a + c - '0';
+				c = next();
+			}
+			return negative ? -a : a;
+		};
+		ll _v = get(), _e = get();
+		if (!ok || _v < 1 || _v > (1ll << 31) - 1 || _e < 0) return false;
+		int* from = new int[_e];
+		int* to = new int[_e];
+		ll* weight = new ll[_e];
+		for (ll i = 0; i < _e && ok; i++)
+		{
+			ll a = get(), b = get();
+			weight[i] = get();
+			if (a < 0 || a >= _v || b < 0 || b >= _v) ok = false;
+			from[i] = a;
+			to[i] = b;
+		}
+		if (ok) build(_v, _e, from, to, weight, _symmetric);
+		delete[] from;
+		delete[] to;
+		delete[] weight;
+		return ok;
+	}
+	bool map(int fd) // Maps a binary file. Returns false if it is not one
+	{	// Only the sizes are checked, so that nothing has to be read up front. Targets are trusted to be vertices
+		clear();
+		struct stat st;
+		if (fstat(fd, &st) || st.st_size < 40) return false;
+		void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED) return false;
+		const ll* header = (const ll*)((const char*)p + 8);
+		ll _v = header[0], _e = header[1], _m = header[2], flags = header[3];
+		bool _symmetric = flags & 1;
+		if (memcmp(p, "HEAPCSR1", 8) || _v < 1 || _v > (1ll << 31) - 1 || _e < 0 || _m != (_symmetric ? 2*_e : _e) ||
+			(size_t)st.st_size != 40 + 8*(_v+1) + _targetbytes(_m) + 8*_m)
+		{
+			munmap(p, st.st_size);
+			return false;
+		}
+		mapped = p;
+		mappedsize = st.st_size;
+		v = _v;
+		e = _e;
+		m = _m;
+		symmetric = _symmetric;
+		offsets = header + 4;
+		targets = (const int*)(offsets + v + 1);
+		weights = (const ll*)((const char*)targets + _targetbytes(m));
+		if (offsets[0] != 0 || offsets[v] != m)
+		{
+			clear();
+			return false;
+		}
+		return true;
+	}
+	bool map(const char* filename)
+	{
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0) return false;
+		bool ok = map(fd);
+		close(fd); // The mapping stays valid
+		return ok;
+	}
+	bool read(FILE* in, bool _symmetric) // Either format, a binary file is mapped if in is redirected from one. Returns false if it is malformed
+	{	// If _symmetric, every edge is stored in both directions, even if the file stores it once
+		int c = getc(in);
+		if (c == EOF) return false;
+		ungetc(c, in);
+		if (c != 'H') return readtext(in, _symmetric);
+		if (!map(fileno(in))) return false;
+		if (_symmetric && !symmetric)
+		{
+			csrgraph s;
+			s.symmetrise(*this);
+			swap(s);
+		}
+		return true;
+	}
+	void swap(csrgraph &g)
+	{
+		std::swap(v, g.v);
+		std::swap(e, g.e);
+		std::swap(m, g.m);
+		std::swap(symmetric, g.symmetric);
+		std::swap(offsets, g.offsets);
+		std::swap(targets, g.targets);
+		std::swap(weights, g.weights);
+		std::swap(mapped, g.mapped);
+		std::swap(mappedsize, g.mappedsize);
+	}
+	bool write(FILE* f) // In the binary format
+	{
+		ll header[4] = {v, e, m, symmetric ? 1 : 0};
+		ll zero = 0;
+		size_t padding = _targetbytes(m) - 4*m;
+		return fwrite("HEAPCSR1", 1, 8, f) == 8 && fwrite(header, 8, 4, f) == 4 && fwrite(offsets, 8, v+1, f) == (size_t)v+1 &&
+			fwrite(targets, 4, m, f) == (size_t)m && fwrite(&zero, 1, padding, f) == padding && fwrite(weights, 8, m, f) == (size_t)m;
+	}
+};
+#endif
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 // Hollow heap (minimum), two-parent, one-tree
 // Amortised O(1) push, decrease-key, merge. O(log(N)) pop/erase
 // Note that N is number of push + decrease-key operations
@@ -7,6 +9,7 @@ template<class T> struct HollowNode // The actual items in the heap
 {
 	typedef struct HollowHeapNode<T>* pnode;
 	pnode inheap;
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 };
 template<class T> struct HollowHeapNode // Node in the heap. Nodes can be hollow or full. Full nodes contain an item, hollow nodes do not.
 {
@@ -20,24 +23,26 @@ template<class T> struct HollowHeapNode // Node in the heap. Nodes can be hollow
 };
 // Memory allocation
 
-template<class T> HollowNode<T>* _hollownewitem()
+template<class T, class A> HollowNode<T>* _hollownewitem(A &alloc)
 {
-	return new HollowNode<T>();
+	return alloc.allocate();
 }
-template<class T> HollowHeapNode<T>* _hollownewnode(HollowNode<T>* item, T val)
+template<class T, class A> HollowHeapNode<T>* _hollownewnode(A &alloc, HollowNode<T>* item, T val)
 {
 	typedef struct HollowHeapNode<T>* pnode;
-	pnode _new = new HollowHeapNode<T>();
+	pnode _new = alloc.allocate();
 	_new->item = item;
 	_new->val = val;
 	item->inheap = _new;
 	return _new;
 }
 
-template<class T> struct hollow
+template<class T, template<class> class Alloc = freelistallocator> struct hollow
 {
 	typedef struct HollowHeapNode<T>* pnode;
 	typedef struct HollowNode<T>* pitem;
+	Alloc<HollowHeapNode<T> > nodealloc; // Allocates the nodes in the heap
+	Alloc<HollowNode<T> > itemalloc; // Allocates the items
 	// Used for intermediary storage during pop
 	int mxrank;
 	pnode ofrank[50];
@@ -51,6 +56,7 @@ template<class T> struct hollow
 
 	pnode root;
 	int sz;
+	bool ownshandles = true; // Whether popped and erased items it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Auxilary functions
 	int size()
 	{
@@ -64,8 +70,13 @@ template<class T> struct hollow
 	{
 		return root->val;
 	}
+	void reclaim(pitem item) // Recycles an item that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !item->callerowned) itemalloc.deallocate(item);
+	}
 	void link(pnode a, pnode b) // Makes a the first child of b
 	{
+		HEAPLINK();
 		a->sibling = b->child;
 		b->child = a;
 	}
@@ -114,6 +125,7 @@ template<class T> struct hollow
 	// Main functions
 	void push(pnode a)
 	{
+		HEAPOP(push);
 		sz++;
 		if (sz == 1) // A is the only node
 		{
@@ -122,18 +134,21 @@ template<class T> struct hollow
 		}
 		insertIntoHeap(a);
 	}
-	void push(pitem item, T val)
+	void push(pitem item, T val) // Inserts an item owned by the caller
 	{
-		push(_hollownewnode<T>(item, val));
+		item->callerowned = true;
+		push(_hollownewnode<T>(nodealloc, item, val));
 	}
-	pitem push(T val)
+	pitem push(T val) // The returned item is valid until it is popped or erased
 	{
-		pitem _new = _hollownewitem<T>();
-		push(_new, val);
+		pitem _new = _hollownewitem<T>(itemalloc);
+		push(_hollownewnode<T>(nodealloc, _new, val));
 		return _new;
 	}
 	void decreasekey(pitem item, T val)
 	{
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		pnode a = item->inheap;
 		if (a == root)
 		{
@@ -141,7 +156,7 @@ template<class T> struct hollow
 			a->val = val;
 			return;
 		}
-		pnode b = _hollownewnode(item, val);
+		pnode b = _hollownewnode<T>(nodealloc, item, val);
 		// Rank of b is max(0, a->rank - 2)
 		if (a->rank > 2) b->rank = a->rank - 2;
 		// Make a hollow, and make b the second parent 	
@@ -152,12 +167,11 @@ template<class T> struct hollow
 	}
 	void pop() // Remove the smallest item from the heap
 	{
+		HEAPOP(pop);
 		sz--;
-		if (!sz) // Heap should now be empty
-		{
-			root = 0;
-			return;
-		}
+		reclaim(root->item);
+		root->item = 0; // The root is now hollow, and is deleted along with the other hollow nodes below
+		// Even if the heap is now empty, this frees any hollow nodes left in it
 		mxrank = 0;
 		pnode l = root; // Linked list of hollow nodes to delete
 		while (l)
@@ -168,6 +182,7 @@ template<class T> struct hollow
 			while (a) // Process all children of v
 			{
 				pnode next = a->sibling;
+				HEAPTOUCH(1);
 				if (a->item) // Is not hollow
 				{
 					a->sibling = 0;
@@ -189,6 +204,7 @@ template<class T> struct hollow
 				}
 				a = next;
 			}
+			nodealloc.deallocate(v); // v is hollow and no longer has a parent
 		}
 		root = 0;
 		// Now, merge all nodes to form one heap
@@ -215,7 +231,12 @@ template<class T> struct hollow
 	}
 	void merge(hollow *a)
 	{
+		HEAPOP(merge);
 		sz += a->sz;
+		// Nodes and items of a are now owned by this heap
+		nodealloc.merge(a->nodealloc);
+		itemalloc.merge(a->itemalloc);
+		ownshandles = ownshandles && a->ownshandles; // Items of a stay valid after pop if a kept them
 		if (!root) // Set root to a->root, since this heap is empty
 		{
 			root = a->root;
@@ -228,8 +249,10 @@ template<class T> struct hollow
 		if (a == root) pop(); // Is the minimum item, do a pop
 		else
 		{
-			a->item = 0; // Make hollow
+			sz--;
+			a->item = 0; // Make hollow, it is deleted during a later pop
 			item->inheap = 0;
+			reclaim(item);
 		}
 	}
 };
\ No newline at end of file
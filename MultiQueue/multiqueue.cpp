@@ -0,0 +1,124 @@
+// MultiQueue: a relaxed concurrent minimum priority queue, made of c * threads sequential heaps, each behind its own lock
+// push() puts the value into a random heap, pop() removes the smaller top of two random heaps
+// Threads rarely wait for the same lock, so throughput grows with the number of threads, at the cost of pop() returning a small value
+// rather than the smallest one: its rank among the values in the queue is O(c * threads) on average
+// H is any heap of T in this library, e.g. multiqueue<int, pairing<int> >, only push(), top(), pop() and empty() are used
+// Every method may be called from any thread. There is no top(), as another thread could pop it before it is used
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <functional>
+struct mqlock // Spinlock, only ever held for one heap operation
+{
+	std::atomic<bool> locked{false};
+	bool trylock()
+	{
+		return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+	}
+	void lock()
+	{
+		while (!trylock()) std::this_thread::yield();
+	}
+	void unlock()
+	{
+		locked.store(false, std::memory_order_release);
+	}
+};
+inline unsigned long long _mqrandom() // Per thread xorshift
+{
+	thread_local unsigned long long x = 0x9e3779b97f4a7c15ull ^ (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id());
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	return x;
+}
+template<class T, class H> struct multiqueue
+{
+	struct alignas(64) queue // One per cache line, so locking one does not slow down its neighbours
+	{
+		mqlock lock;
+		H heap;
+	};
+	int n; // Number of heaps
+	queue* queues;
+	std::atomic<long long> sz{0};
+	multiqueue(int threads, int c = 2)
+	{
+		n = threads*c < 2 ? 2 : threads*c;
+		queues = new queue[n];
+	}
+	multiqueue(const multiqueue&) = delete;
+	multiqueue& operator=(const multiqueue&) = delete;
+	~multiqueue()
+	{
+		delete[] queues;
+	}
+	long long size() // Exact once every thread has stopped
+	{
+		return sz.load(std::memory_order_relaxed);
+	}
+	bool empty()
+	{
+		return !size();
+	}
+	void push(T val)
+	{
+		while (true)
+		{
+			queue &q = queues[_mqrandom() % n];
+			if (!q.lock.trylock()) continue; // Another thread has it, try another heap
+			q.heap.push(val);
+			sz.fetch_add(1, std::memory_order_relaxed);
+			q.lock.unlock();
+			return;
+		}
+	}
+	bool pop(T &val) // Removes a small value into val, returns false if the queue is empty
+	{
+		for (int attempt = 0; ; attempt++)
+		{
+			if (empty()) return false;
+			if (attempt >= 4*n) return popscan(val); // Values are left in few heaps, random choices are unlikely to find them
+			unsigned long long r = _mqrandom();
+			int i = r % n, j = (r >> 32) % n;
+			if (i == j) j = (j+1) % n;
+			if (!queues[i].lock.trylock()) continue;
+			if (!queues[j].lock.trylock())
+			{
+				queues[i].lock.unlock();
+				continue;
+			}
+			H* a = &queues[i].heap;
+			H* b = &queues[j].heap;
+			if (a->empty() || (!b->empty() && b->top() < a->top())) std::swap(a, b);
+			bool found = !a->empty();
+			if (found)
+			{
+				val = a->top();
+				a->pop();
+				sz.fetch_sub(1, std::memory_order_relaxed);
+			}
+			queues[i].lock.unlock();
+			queues[j].lock.unlock();
+			if (found) return true;
+		}
+	}
+	bool popscan(T &val) // Pops the top of the first nonempty heap
+	{
+		for (int i = 0; i < n; i++)
+		{
+			queue &q = queues[i];
+			q.lock.lock();
+			bool found = !q.heap.empty();
+			if (found)
+			{
+				val = q.heap.top();
+				q.heap.pop();
+				sz.fetch_sub(1, std::memory_order_relaxed);
+			}
+			q.lock.unlock();
+			if (found) return true;
+		}
+		return false;
+	}
+};
@@ -1,23 +1,33 @@
 // Pairing Heap with push, pop, erase, top (minimum), merge & decrease key
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 template<class T> struct PairingNode
 {
 	typedef struct PairingNode<T>* pnode;
 	T val; // Value of the node
 	pnode child, left, right; // Point to leftmost child, left sibling and right sibling
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 	// If a node is the leftmost child, left points to the parent.
 };
-template<class T> PairingNode<T>* _pairingnewnode(T val)
+template<class T, class A> PairingNode<T>* _pairingnewnode(A &alloc, T val)
 {
 	typedef struct PairingNode<T>* pnode;
-	pnode _new = new PairingNode<T>(); // Other method of allocating memory
+	pnode _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
-template<class T> struct pairing
+enum pairingpass // How the children of the root are combined during pop
+{
+	pairingtwopass, // Merge pairs left to right, then merge the pairs right to left
+	pairingmultipass // Repeatedly merge the first two trees of a queue, adding the result to the back
+};
+template<class T, template<class> class Alloc = freelistallocator, int Pass = pairingtwopass> struct pairing
 {
 	typedef struct PairingNode<T>* pnode;
+	Alloc<PairingNode<T> > alloc; // Allocates the nodes of this heap
 	pnode root = 0; // Pointer to root
 	int sz = 0; // Number of elements in the heap
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Auxiliary functions
 	int size()
 	{
@@ -37,6 +47,10 @@ template<class T> struct pairing
 		a = b;
 		b = c;
 	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
 
 	// Main functions
 	pnode merge(pnode a, pnode b) // Merges two heaps into one heap
@@ -44,6 +58,7 @@ template<class T> struct pairing
 		if (!b) return a;
 		if (!a) return b;
 		if (b->val < a->val) swap(a, b); // Make the heap with the smallest root the new root
+		HEAPLINK();
 		b->right = a->child;
 		if (b->right) b->right->left = b;
 		a->child = b;
@@ -52,10 +67,13 @@ template<class T> struct pairing
 	}
 	void merge(pairing *a) // Merges a heap into this heap
 	{
+		HEAPOP(merge);
 		sz += a->sz;
 		root = merge(root, a->root);
+		alloc.merge(a->alloc); // Nodes of a are now owned by this heap
+		ownshandles = ownshandles && a->ownshandles; // Nodes of a stay valid after pop if a kept them
 	}
-	void push(pnode _new) // Inserts a pnode into the heap
+	void insert(pnode _new) // Inserts a pnode into the heap
 	{
 		sz++;
 		if (sz == 1) // Just make this node the heap
@@ -63,6 +81,7 @@ template<class T> struct pairing
 			root = _new;
 			return;
 		}
+		HEAPLINK();
 		if (_new->val < root->val) // Make _new the new root
 		{
 			_new->child = root;
@@ -77,30 +96,88 @@ template<class T> struct pairing
 			_new->left = root;
 		}
 	}
-	pnode push(T val) // Inserts an element into the heap
+	void push(pnode _new) // Inserts a pnode owned by the caller into the heap
 	{
-		pnode _new = _pairingnewnode<T>(val);
-		push(_new);
+		HEAPOP(push);
+		_new->callerowned = true;
+		insert(_new);
+	}
+	pnode push(T val) // Inserts an element into the heap. The returned node is valid until the element is popped
+	{
+		HEAPOP(push);
+		pnode _new = _pairingnewnode<T>(alloc, val);
+		insert(_new);
 		return _new;
 	}
-	pnode recursivemerge(pnode a) // Helps with the pop function. First merges pairs of trees, then merges the pairs into one tree
+	pnode twopass(pnode a) // Helps with the pop function. First merges pairs of trees, then merges the pairs into one tree
+	{	// Iterative, so the stack does not overflow when the root has millions of children
+		pnode pairs = nullptr; // Stack of merged pairs, linked through right
+		while (a)
+		{
+			pnode b = a->right;
+			if (!b) // Odd tree out, it is the rightmost 'pair'
+			{
+				HEAPTOUCH(1);
+				a->right = pairs;
+				pairs = a;
+				break;
+			}
+			pnode c = b->right;
+			a = merge(a, b);
+			a->right = pairs;
+			pairs = a;
+			a = c;
+		}
+		// Merge the pairs from right to left
+		a = nullptr;
+		while (pairs)
+		{
+			pnode b = pairs->right;
+			a = merge(pairs, a);
+			pairs = b;
+		}
+		return a;
+	}
+	pnode multipass(pnode a) // Helps with the pop function. Merges the first two trees, and places the result at the back, until one is left
 	{
 		if (!a) return a;
-		pnode b = a->right;
-		if (!b) return a;
-		pnode c = b->right;
-		return merge(merge(a, b), recursivemerge(c));
+		pnode back = a;
+		while (back->right) // Find the back of the queue
+		{
+			back = back->right;
+			HEAPTOUCH(1);
+		}
+		while (a->right)
+		{
+			pnode b = a->right;
+			pnode c = b->right;
+			a = merge(a, b);
+			a->right = nullptr;
+			if (!c) return a; // These were the last two trees
+			back->right = a;
+			back = a;
+			a = c;
+		}
+		return a;
 	}
 	void pop() // Removes the largest element from the heap
 	{
+		HEAPOP(pop);
+		HEAPTOUCH(1);
 		sz--;
-		root = recursivemerge(root->child);
+		pnode a = root;
+		if (Pass == pairingmultipass) root = multipass(root->child);
+		else root = twopass(root->child);
 		if (root) root->right = nullptr;
+		reclaim(a);
 	}
 	void decreasekey(pnode a, T val)
 	{
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
 		if (a == root) return;
+		HEAPCUT();
 		if (a->left->child == a) // A is the leftmost child
 		{
 			a->left->child = a->right;
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 // Quake heap, O(1) push, decrease-key, O(log(n)) pop, merge
 #define MXRANK 60
 #define A1 4 // Required ratio of amounts of each rank = A1/A2
@@ -9,6 +11,7 @@ template<class T> struct QuakeNode
 	typedef struct QuakeHeapNode<T>* pnode;
 	pnode inheap; // Highest occurrence of it in the heap
 	T val; // Value
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 };
 template<class T> struct QuakeHeapNode
 {
@@ -21,34 +24,37 @@ template<class T> struct QuakeHeapNode
 	int rank;
 };
 // Used for allocating memory for QuakeNode
-template<class T> QuakeNode<T>* quakenewvaluenode(T val)
+template<class T, class A> QuakeNode<T>* quakenewvaluenode(A &alloc, T val)
 {
 	typedef struct QuakeNode<T>* pvalue;
-	pvalue _new = new QuakeNode<T>();
+	pvalue _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
 
-template<class T> void deletenode(QuakeHeapNode<T>* a)
+template<class T, class A> void deletenode(A &alloc, QuakeHeapNode<T>* a)
 {
-	delete a;
+	alloc.deallocate(a);
 }
-template<class T> QuakeHeapNode<T>* _quakenewnode()
+template<class T, class A> QuakeHeapNode<T>* _quakenewnode(A &alloc)
 {
 	typedef struct QuakeHeapNode<T>* pnode;
-	pnode _new = new QuakeHeapNode<T>();
+	pnode _new = alloc.allocate();
 	_new->rank = 0;
 	return _new;
 }
-template<class T> struct quake
+template<class T, template<class> class Alloc = freelistallocator> struct quake
 {
 	typedef struct QuakeHeapNode<T>* pnode;
 	typedef struct QuakeNode<T>* pvalue;
+	Alloc<QuakeHeapNode<T> > nodealloc; // Allocates the tournament nodes
+	Alloc<QuakeNode<T> > valuealloc; // Allocates the values
 	pnode root = nullptr;
 	int sz = 0;
 	int am[MXRANK]; // Stores the amount of nodes of each rank
 	int mxrank = 0;
 	pnode ofrank[MXRANK]; // Used for intermediary storage during pop
+	bool ownshandles = true; // Whether popped values it allocated are given back to the allocator. Clear it to keep them valid after pop
 	quake() // Initialise
 	{
 		root = nullptr;
@@ -69,6 +75,10 @@ template<class T> struct quake
 	{
 		return root->val->val;
 	}
+	void reclaim(pvalue a) // Recycles a value that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) valuealloc.deallocate(a);
+	}
 	void insertIntoHeap(pnode a, pnode &root) // Inserts a into the heap rooted at root
 	{
 		a->par = nullptr;
@@ -89,7 +99,8 @@ template<class T> struct quake
 	pnode mergetrees(pnode a, pnode b)
 	{
 		// Create a new node, c which will be the parent of a and b
-		pnode c = _quakenewnode<T>();
+		HEAPLINK();
+		pnode c = _quakenewnode<T>(nodealloc);
 		c->rank = a->rank+1;
 		am[c->rank]++; // One more node of this rank
 		c->left = a;
@@ -119,6 +130,7 @@ template<class T> struct quake
 	}
 	void quakeoperation(pnode a, int hei) // Quake operation, remove all nodes of rank > hei
 	{
+		HEAPTOUCH(1);
 		if (a->rank <= hei)
 		{
 			// We should keep this one, insert it into the heap
@@ -132,24 +144,31 @@ template<class T> struct quake
 			if (a->left) quakeoperation(a->left, hei);
 			if (a->right) quakeoperation(a->right, hei);
 			am[a->rank]--;
-			deletenode(a);
+			deletenode(nodealloc, a);
 		}
 	}
 
 	// Main functions
-	void push(pvalue val)
+	void push(pvalue val) // Inserts a value owned by the caller
+	{
+		val->callerowned = true;
+		insert(val);
+	}
+	void insert(pvalue val)
 	{
+		HEAPOP(push);
+		HEAPTOUCH(1);
 		sz++;
-		pnode a = _quakenewnode<T>();
+		pnode a = _quakenewnode<T>(nodealloc);
 		a->val = val;
 		val->inheap = a;
 		am[0]++; // Another node of rank 0
 		insertIntoHeap(a, root);
 	}
-	pvalue push(T val)
+	pvalue push(T val) // The returned value is valid until it is popped
 	{
-		pvalue _new = quakenewvaluenode(val);
-		push(_new);
+		pvalue _new = quakenewvaluenode<T>(valuealloc, val);
+		insert(_new);
 		return _new;
 	}
 	void merge(pnode a)
@@ -171,7 +190,12 @@ template<class T> struct quake
 	}
 	void merge(quake *a)
 	{
+		HEAPOP(merge);
 		sz += a->sz;
+		// Nodes and values of a are now owned by this heap
+		nodealloc.merge(a->nodealloc);
+		valuealloc.merge(a->valuealloc);
+		ownshandles = ownshandles && a->ownshandles; // Values of a stay valid after pop if a kept them
 		merge(a->root);
 		// Then, merge the rank lists
 		for (int i = 0; i <= a->mxrank; i++) am[i] += a->am[i];
@@ -179,10 +203,23 @@ template<class T> struct quake
 	}
 	void pop()
 	{	
+		HEAPOP(pop);
 		sz--;
+		pvalue old = root->val; // Recycled once the pop is done
 		if (!sz)
 		{
+			// The only tree left is a path of nodes holding the popped value, delete it
+			pnode a = root;
+			while (a)
+			{
+				pnode next = a->left ? a->left : a->right;
+				HEAPTOUCH(1);
+				am[a->rank]--;
+				deletenode(nodealloc, a);
+				a = next;
+			}
 			root = nullptr;
+			reclaim(old);
 			return;
 		}
 		mxrank = 0;
@@ -190,6 +227,7 @@ template<class T> struct quake
 		pnode a = root->r;
 		while (a != root)
 		{
+			HEAPTOUCH(1);
 			addNode(a);
 			a = a->r;
 		}
@@ -198,6 +236,7 @@ template<class T> struct quake
 		while (true)
 		{
 			pnode b = a;
+			HEAPTOUCH(1);
 			am[a->rank]--;
 			if (a->left && a->right)
 			{
@@ -217,10 +256,10 @@ template<class T> struct quake
 			else if (a->right) a = a->right;
 			else
 			{
-				deletenode(a);
+				deletenode(nodealloc, a);
 				break;
 			}
-			deletenode(b);
+			deletenode(nodealloc, b);
 		}
 		// Construct new heap
 		root = nullptr;
@@ -251,13 +290,17 @@ template<class T> struct quake
 				break;
 			}
 		}
+		reclaim(old);
 	}
 	void decreasekey(pvalue a, T val)
 	{
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
 		pnode x = a->inheap;
 		if (x->par) // Needs to be cut from tree, reinserted
 		{
+			HEAPCUT();
 			// Remove from parent
 			if (x->par->left == x) x->par->left = nullptr;
 			else x->par->right = nullptr;
@@ -0,0 +1,213 @@
+// Radix heap (minimum) for monotone integer keys, with push, pop, top & decrease key
+// O(1) push & decrease key, amortised O(log C) pop where C is the largest key
+// Monotone: every key pushed or decreased to must be at least the last key popped (or seen by top), as in Dijkstra's algorithm
+// Keys are integers, or std::pair<integer, X> where only the first element is used to place the pair in a bucket
+// Ties between equal keys are broken arbitrarily
+#include <utility>
+#include "../Allocator/allocator.cpp"
+template<class T> unsigned long long _radixkey(const T &a)
+{
+	return a;
+}
+template<class A, class B> unsigned long long _radixkey(const std::pair<A, B> &a)
+{
+	return a.first;
+}
+int _radixbucket(unsigned long long key, unsigned long long last) // Bucket i holds keys that first differ from last in bit i-1, bucket 0 holds last
+{
+	return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+}
+
+// Without decrease-key. Buckets are arrays of values
+template<class T> struct radix
+{
+	T* bucket[65]; // Values in each bucket
+	int bsz[65], bcap[65]; // Size & capacity of each bucket
+	unsigned long long last = 0; // Last key popped, every key in the heap is at least this
+	int sz = 0;
+	radix()
+	{
+		for (int i = 0; i < 65; i++)
+		{
+			bucket[i] = nullptr;
+			bsz[i] = bcap[i] = 0;
+		}
+	}
+	radix(const radix&) = delete; // Owns its buckets
+	radix& operator=(const radix&) = delete;
+	~radix()
+	{
+		for (int i = 0; i < 65; i++) delete[] bucket[i];
+	}
+	// Auxilary functions
+	int size()
+	{
+		return sz;
+	}
+	bool empty()
+	{
+		return !sz;
+	}
+	void add(int b, const T &val) // Adds val to the end of bucket b, doubling it if it is full
+	{
+		if (bsz[b] == bcap[b])
+		{
+			bcap[b] = bcap[b] ? 2*bcap[b] : 16;
+			T* _new = new T[bcap[b]];
+			for (int i = 0; i < bsz[b]; i++) _new[i] = bucket[b][i];
+			delete[] bucket[b];
+			bucket[b] = _new;
+		}
+		bucket[b][bsz[b]++] = val;
+	}
+	void pull() // Makes sure bucket 0 is not empty
+	{
+		if (bsz[0]) return;
+		int b = 1;
+		while (!bsz[b]) b++; // First non-empty bucket
+		// The smallest key in it becomes last, then every value in it moves to a lower bucket
+		unsigned long long mn = _radixkey(bucket[b][0]);
+		for (int i = 1; i < bsz[b]; i++)
+		{
+			if (_radixkey(bucket[b][i]) < mn) mn = _radixkey(bucket[b][i]);
+		}
+		last = mn;
+		for (int i = 0; i < bsz[b]; i++) add(_radixbucket(_radixkey(bucket[b][i]), last), bucket[b][i]);
+		bsz[b] = 0;
+	}
+
+	// Main functions
+	T top()
+	{
+		pull();
+		return bucket[0][bsz[0]-1];
+	}
+	void push(T val)
+	{
+		sz++;
+		add(_radixbucket(_radixkey(val), last), val);
+	}
+	void pop()
+	{
+		pull();
+		bsz[0]--;
+		sz--;
+	}
+};
+
+// With decrease-key. Buckets are doubly linked lists of nodes
+template<class T> struct RadixNode
+{
+	typedef struct RadixNode<T>* pnode;
+	T val; // Value of the node
+	int bucket; // Bucket the node is in
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
+	pnode left, right; // Neighbours in the bucket
+};
+template<class T, template<class> class Alloc = freelistallocator> struct radixdk
+{
+	typedef struct RadixNode<T>* pnode;
+	Alloc<RadixNode<T> > alloc; // Allocates the nodes of this heap
+	pnode bucket[65]; // First node in each bucket
+	unsigned long long last = 0; // Last key popped, every key in the heap is at least this
+	int sz = 0;
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
+	radixdk()
+	{
+		for (int i = 0; i < 65; i++) bucket[i] = nullptr;
+	}
+	// Auxilary functions
+	int size()
+	{
+		return sz;
+	}
+	bool empty()
+	{
+		return !sz;
+	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
+	void link(pnode a) // Adds a to the front of its bucket
+	{
+		int b = _radixbucket(_radixkey(a->val), last);
+		a->bucket = b;
+		a->left = nullptr;
+		a->right = bucket[b];
+		if (a->right) a->right->left = a;
+		bucket[b] = a;
+	}
+	void unlink(pnode a) // Removes a from its bucket
+	{
+		if (a->left) a->left->right = a->right;
+		else bucket[a->bucket] = a->right;
+		if (a->right) a->right->left = a->left;
+	}
+	void pull() // Makes sure bucket 0 is not empty
+	{
+		if (bucket[0]) return;
+		int b = 1;
+		while (!bucket[b]) b++; // First non-empty bucket
+		// The smallest key in it becomes last, then every node in it moves to a lower bucket
+		pnode a = bucket[b];
+		unsigned long long mn = _radixkey(a->val);
+		for (a = a->right; a; a = a->right)
+		{
+			if (_radixkey(a->val) < mn) mn = _radixkey(a->val);
+		}
+		last = mn;
+		a = bucket[b];
+		bucket[b] = nullptr;
+		while (a)
+		{
+			pnode next = a->right;
+			link(a);
+			a = next;
+		}
+	}
+
+	// Main functions
+	T top()
+	{
+		pull();
+		return bucket[0]->val;
+	}
+	void push(pnode a) // Inserts a node owned by the caller
+	{
+		a->callerowned = true;
+		sz++;
+		link(a);
+	}
+	pnode push(T val) // The returned node is valid until it is popped
+	{
+		pnode a = alloc.allocate();
+		a->val = val;
+		sz++;
+		link(a);
+		return a;
+	}
+	void pop()
+	{
+		pull();
+		pnode a = bucket[0];
+		unlink(a);
+		sz--;
+		reclaim(a);
+	}
+	void decreasekey(pnode a, T val) // val must be at least the last key popped
+	{
+		a->val = val;
+		if (_radixbucket(_radixkey(val), last) != a->bucket) // Move to its new bucket
+		{
+			unlink(a);
+			link(a);
+		}
+	}
+	void erase(pnode a)
+	{
+		unlink(a);
+		sz--;
+		reclaim(a);
+	}
+};
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 // Minimum rank-pairing heap. 
 template<class T> struct RankPairingNode
 {
@@ -7,22 +9,25 @@ template<class T> struct RankPairingNode
 	int rank; // Value of the node
 	pnode par, left, right; // Structure is maintained as a binary heap maintaining partial heap order. In particular, the left children satifsy it.
 	bool isRoot; // Stores if the node is a root
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 	// Note: Roots are stored in a doubly linked circular linked list. 
 	// In this case, left and right refer to the left and right siblings in this list
 	// The root will have one left child, which will be stored in the par pointer. 
 };
-template<class T> RankPairingNode<T>* _newrankpairingnode(T val)
+template<class T, class A> RankPairingNode<T>* _newrankpairingnode(A &alloc, T val)
 {
 	typedef struct RankPairingNode<T>* pnode;
-	pnode _new = new RankPairingNode<T>();
+	pnode _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
-template<class T> struct rankpairing
+template<class T, template<class> class Alloc = freelistallocator> struct rankpairing
 {
 	typedef struct RankPairingNode<T>* pnode;
+	Alloc<RankPairingNode<T> > alloc; // Allocates the nodes of this heap
 	int sz = 0;
 	pnode root = nullptr;
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
 	pnode nodesOfRank[50]; // Used for intermediate storage during pop functions
 	rankpairing()
 	{
@@ -47,6 +52,10 @@ template<class T> struct rankpairing
 		a = b;
 		b = c;
 	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
 	void addIntoHeap(pnode &root, pnode a) // Inserts a into the heap rooted at root
 	{
 		a->isRoot = 1;
@@ -65,6 +74,7 @@ template<class T> struct rankpairing
 	}
 	pnode mergetrees(pnode x, pnode y) // Merges trees with equal rank into one tree
 	{
+		HEAPLINK();
 		if (x->val > y->val) swap(x, y); // Guarantee that x->val <= y->val
 		// Make y the left child of x, stored in the par pointer
 		y->left = y->par;
@@ -78,14 +88,19 @@ template<class T> struct rankpairing
 	}
 
 	// Main functions
-	void push(pnode a) // Add the node a into the heap
+	void push(pnode a) // Add the node a, owned by the caller, into the heap
 	{
+		a->callerowned = true;
+		HEAPOP(push);
+		HEAPTOUCH(1);
 		sz++;
 		addIntoHeap(root, a);
 	}
-	pnode push(T val) // Add the value a into the heap
+	pnode push(T val) // Add the value a into the heap. The returned node is valid until it is popped
 	{
-		pnode a = _newrankpairingnode<T>(val);
+		HEAPOP(push);
+		HEAPTOUCH(1);
+		pnode a = _newrankpairingnode<T>(alloc, val);
 		sz++;
 		addIntoHeap(root, a);
 		return a;
@@ -93,7 +108,10 @@ template<class T> struct rankpairing
 	void merge(rankpairing* a)
 	{
 		if (!a->root) return;
+		HEAPOP(merge);
 		sz+=a->sz;
+		alloc.merge(a->alloc); // Nodes of a are now owned by this heap
+		ownshandles = ownshandles && a->ownshandles; // Nodes of a stay valid after pop if a kept them
 		if (!root)
 		{
 			root = a->root;
@@ -120,6 +138,7 @@ template<class T> struct rankpairing
 	}
 	void pop() // Removes root from the heap
 	{
+		HEAPOP(pop);
 		sz--;
 		pnode newroot = nullptr;
 		int mxrank = 0; // Maximum rank seen
@@ -127,6 +146,7 @@ template<class T> struct rankpairing
 		while (c) // Insert the chain of right children into new heap
 		{
 			pnode d = c->right; // Next node to be processed
+			HEAPTOUCH(1);
 			c->rank = rank(c->left)+1;
 			c->par = c->left;
 			if (nodesOfRank[c->rank]) // Do merge, insert into heap
@@ -146,6 +166,7 @@ template<class T> struct rankpairing
 		while (c != root) 
 		{
 			pnode d = c->right; // Next node to be processed
+			HEAPTOUCH(1);
 			if (nodesOfRank[c->rank]) // Do merge, insert into heap
 			{
 				pnode a = nodesOfRank[c->rank];
@@ -168,10 +189,13 @@ template<class T> struct rankpairing
 				nodesOfRank[i] = nullptr;
 			}
 		}
+		reclaim(root);
 		root = newroot;
 	}
 	void decreasekey(pnode a, T val) // Decrease the value at a to val. Uses type-2 rank reduction 
 	{
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
 		if (a->isRoot) 
 		{
@@ -179,6 +203,7 @@ template<class T> struct rankpairing
 			return;
 		}
 		// Detach a from its parent, and set its right child in its place
+		HEAPCUT();
 		pnode p = a->par;
 		pnode c = a->right;
 		// Replace a with c as p's child
@@ -193,6 +218,7 @@ template<class T> struct rankpairing
 		// Do the rank-decrease step
 		while (true)
 		{
+			HEAPTOUCH(1);
 			if (p->isRoot) // Set to rank(child)+1
 			{
 				p->rank = rank(p->par)+1;
@@ -0,0 +1,289 @@
+// Lock-free minimum priority queue on a skiplist, after Lindén and Jonsson, "A Skiplist-Based Concurrent Priority Queue with Minimal Memory Contention"
+// pop() does not unlink the smallest node, it only marks it deleted, by setting the lowest bit of its predecessor's bottom level pointer with one
+// fetch_or. The deleted nodes always form a prefix of the list, so a pop that loses the race moves on to the next node instead of retrying
+// Once a pop has walked past more than boundoffset deleted nodes, it unlinks the prefix all at once by moving the head's pointers past it
+// push() links a new node after the deleted prefix, at the bottom level first, then at the levels above it, with compare-and-swap
+// Unlinked nodes are freed with epoch based reclamation, once every operation that could still be reading them has finished
+// Each thread has its own reclamation record in each queue it uses, added to a lock-free list the first time, so no operation waits for another
+// thread. Records are only freed with the queue
+// Every method may be called from any thread. top() and empty() may be out of date when they return, pop(val) removes and returns the minimum
+// in one step. There is no decrease-key or merge
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <functional>
+template<class T> struct alignas(std::atomic<uintptr_t>) SkiplistNode
+{
+	T val;
+	int level; // Number of levels it is linked at
+	std::atomic<bool> inserting; // Whether push() may still link it at more levels, the nodes from it on are not unlinked until it is done
+	SkiplistNode(const T &v, int l) : val(v), level(l), inserting(false)
+	{
+		for (int i = 0; i < l; i++) new (&next()[i]) std::atomic<uintptr_t>(0);
+	}
+	std::atomic<uintptr_t>* next() // The pointers of each level, stored right after the node. At the bottom level, the lowest bit marks the next node deleted
+	{
+		return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1);
+	}
+};
+template<class T> struct skiplist
+{
+	typedef SkiplistNode<T>* pnode;
+	static const int maxlevel = 32;
+	struct alignas(64) record // Of one thread
+	{
+		std::atomic<bool> active{false}; // Whether the thread is in an operation
+		std::atomic<unsigned long long> epoch{0}; // Epoch the operation started in
+		std::vector<pnode> limbo[3]; // Nodes unlinked in epoch limboepoch[i], waiting to be freed
+		unsigned long long limboepoch[3] = {0, 0, 0};
+		int retired = 0;
+		record* next = nullptr; // In the list of records, which only grows
+	};
+	struct guard
+	{
+		skiplist &q;
+		record* s;
+		guard(skiplist &_q) : q(_q)
+		{
+			s = q.enter();
+		}
+		~guard()
+		{
+			q.leave(s);
+		}
+	};
+	pnode head, tail;
+	int boundoffset;
+	std::atomic<unsigned long long> epoch{0};
+	std::atomic<record*> records{nullptr};
+	static inline std::atomic<unsigned long long> ids{0};
+	const unsigned long long id = ids++; // Tells the queues apart in the threads' lists of their records, as an address may be reused
+	skiplist(int _boundoffset = 32) : boundoffset(_boundoffset)
+	{
+		head = create(T(), maxlevel);
+		tail = create(T(), 1);
+		for (int i = 0; i < maxlevel; i++) head->next()[i].store((uintptr_t)tail);
+	}
+	skiplist(const skiplist&) = delete;
+	skiplist& operator=(const skiplist&) = delete;
+	~skiplist()
+	{
+		for (pnode x = head; x; )
+		{
+			pnode next = x == tail ? nullptr : ptr(x->next()[0].load());
+			destroy(x);
+			x = next;
+		}
+		for (record* r = records.load(); r; )
+		{
+			for (std::vector<pnode> &l : r->limbo) for (pnode x : l) destroy(x);
+			record* next = r->next;
+			delete r;
+			r = next;
+		}
+	}
+	static pnode ptr(uintptr_t p)
+	{
+		return (pnode)(p & ~(uintptr_t)1);
+	}
+	static bool marked(uintptr_t p)
+	{
+		return p & 1;
+	}
+	static pnode create(const T &val, int level)
+	{
+		void* p = ::operator new(sizeof(SkiplistNode<T>) + level * sizeof(std::atomic<uintptr_t>));
+		return new (p) SkiplistNode<T>(val, level);
+	}
+	static void destroy(pnode x)
+	{
+		x->~SkiplistNode<T>();
+		::operator delete(x);
+	}
+	static unsigned long long random() // Per thread xorshift
+	{
+		thread_local unsigned long long x = 0x9e3779b97f4a7c15ull ^ (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id());
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		return x;
+	}
+	record* mine() // The record of this thread, added to the list the first time it uses this queue
+	{
+		thread_local std::vector<std::pair<unsigned long long, record*> > cache; // Of each queue this thread has used
+		for (const std::pair<unsigned long long, record*> &c : cache) if (c.first == id) return c.second;
+		record* r = new record();
+		r->next = records.load();
+		while (!records.compare_exchange_weak(r->next, r)) {}
+		cache.emplace_back(id, r);
+		return r;
+	}
+	record* enter() // Announces that this thread is in an operation, and the current epoch
+	{
+		record* s = mine();
+		s->active.store(true);
+		while (true) // advance() may have read the epoch this record had before, so it is only announced once the epoch is seen unchanged
+		{
+			unsigned long long e = epoch.load();
+			s->epoch.store(e);
+			if (epoch.load() == e) break;
+		}
+		return s;
+	}
+	void leave(record* s)
+	{
+		s->active.store(false, std::memory_order_release);
+	}
+	void advance() // Starts the next epoch if every operation in progress started in the current one
+	{
+		unsigned long long e = epoch.load();
+		for (record* r = records.load(); r; r = r->next) if (r->active.load() && r->epoch.load() != e) return;
+		epoch.compare_exchange_strong(e, e+1);
+	}
+	void retire(record* s, pnode x) // x has been unlinked. It is freed once the epoch is two past the one s started in
+	{
+		unsigned long long e = s->epoch.load(std::memory_order_relaxed);
+		std::vector<pnode> &l = s->limbo[e % 3];
+		if (s->limboepoch[e % 3] != e) // Unlinked at least three epochs ago
+		{
+			for (pnode y : l) destroy(y);
+			l.clear();
+			s->limboepoch[e % 3] = e;
+		}
+		l.push_back(x);
+		if (++s->retired % 64 == 0) advance();
+	}
+	pnode locate(const T &val, pnode* preds, pnode* succs) // The nodes around the place of val at each level, after the deleted prefix
+	{
+		pnode del = nullptr; // Last deleted node passed at the bottom level
+		pnode pred = head;
+		for (int i = maxlevel-1; i >= 0; i--)
+		{
+			uintptr_t p = pred->next()[i].load();
+			bool d = marked(p); // Whether cur is deleted, only known at the bottom level
+			pnode cur = ptr(p);
+			while (cur != tail && (cur->val < val || marked(cur->next()[0].load()) || (d && !i)))
+			{
+				if (d && !i) del = cur;
+				pred = cur;
+				p = pred->next()[i].load();
+				d = marked(p);
+				cur = ptr(p);
+			}
+			preds[i] = pred;
+			succs[i] = cur;
+		}
+		return del;
+	}
+	void push(const T &val)
+	{
+		guard g(*this);
+		int level = 1;
+		for (unsigned long long r = random(); level < maxlevel && (r & 1); r >>= 1) level++;
+		pnode x = create(val, level);
+		x->inserting.store(true);
+		pnode preds[maxlevel], succs[maxlevel];
+		pnode del;
+		while (true)
+		{
+			del = locate(val, preds, succs);
+			x->next()[0].store((uintptr_t)succs[0]);
+			uintptr_t expected = (uintptr_t)succs[0]; // Fails if a pop has marked succs[0] deleted
+			if (preds[0]->next()[0].compare_exchange_strong(expected, (uintptr_t)x)) break;
+		}
+		for (int i = 1; i < level; )
+		{
+			x->next()[i].store((uintptr_t)succs[i]);
+			if (marked(x->next()[0].load()) || marked(succs[i]->next()[0].load()) || del == succs[i]) break; // x or succs[i] is deleted
+			uintptr_t expected = (uintptr_t)succs[i];
+			if (preds[i]->next()[i].compare_exchange_strong(expected, (uintptr_t)x)) i++;
+			else
+			{
+				del = locate(val, preds, succs);
+				if (succs[0] != x) break; // x is deleted
+			}
+		}
+		x->inserting.store(false);
+	}
+	bool pop(T &val) // Removes the minimum into val, returns false if the queue is empty
+	{
+		guard g(*this);
+		pnode x = head;
+		pnode newhead = nullptr; // The nodes before it are unlinked
+		int offset = 0;
+		uintptr_t obshead = head->next()[0].load();
+		uintptr_t next;
+		do
+		{
+			next = x->next()[0].load();
+			if (ptr(next) == tail) return false;
+			if (!newhead && x->inserting.load()) newhead = x;
+			if (!marked(next)) next = x->next()[0].fetch_or(1); // Marks the node after x deleted, unless another pop got there first
+			offset++;
+			x = ptr(next);
+		} while (marked(next));
+		val = x->val;
+		if (!newhead) newhead = x;
+		if (offset <= boundoffset || head->next()[0].load() != obshead) return true;
+		if (head->next()[0].compare_exchange_strong(obshead, (uintptr_t)newhead | 1))
+		{
+			restructure();
+			for (pnode cur = ptr(obshead); cur != newhead; )
+			{
+				pnode next = ptr(cur->next()[0].load());
+				retire(g.s, cur);
+				cur = next;
+			}
+		}
+		return true;
+	}
+	void restructure() // Moves the head past the deleted prefix at the levels above the bottom one
+	{
+		pnode pred = head;
+		for (int i = maxlevel-1; i > 0; )
+		{
+			uintptr_t h = head->next()[i].load();
+			if (!marked(ptr(h)->next()[0].load()))
+			{
+				i--;
+				continue;
+			}
+			pnode cur = ptr(pred->next()[i].load());
+			while (marked(cur->next()[0].load()))
+			{
+				pred = cur;
+				cur = ptr(pred->next()[i].load());
+			}
+			if (head->next()[i].compare_exchange_strong(h, pred->next()[i].load())) i--;
+		}
+	}
+	pnode first() // First node that is not deleted, tail if none
+	{
+		pnode x = head;
+		uintptr_t next;
+		do
+		{
+			next = x->next()[0].load();
+			x = ptr(next);
+		} while (marked(next));
+		return x;
+	}
+	T top() // The queue must not be empty
+	{
+		guard g(*this);
+		return first()->val;
+	}
+	void pop()
+	{
+		T val;
+		pop(val);
+	}
+	bool empty()
+	{
+		guard g(*this);
+		return first() == tail;
+	}
+};
@@ -1,22 +1,27 @@
 // Smooth Heap (minimum), forest
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 template<class T> struct SmoothNode
 {
 	typedef struct SmoothNode<T>* pnode;
 	T val;
 	pnode left, right, child, par; // Left and right siblings in tree/heap, leftmost child, parent
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 	// Need these pointers to support access to: Left & right siblings of a node for removal during decrease-key
 	// + Need parent because leftmost child can no longer store parent because it needs to store rightmost sibling
 };
 // Memory allocation
-template<class T> SmoothNode<T>* _newsmoothnode()
+template<class T, class A> SmoothNode<T>* _newsmoothnode(A &alloc)
 {
-	return new SmoothNode<T>();
+	return alloc.allocate();
 } 
-template<class T> struct smooth
+template<class T, template<class> class Alloc = freelistallocator> struct smooth
 {
 	typedef struct SmoothNode<T>* pnode;
+	Alloc<SmoothNode<T> > alloc; // Allocates the nodes of this heap
 	int sz = 0;
 	pnode root = nullptr;
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Auxilary functions
 	int size()
 	{
@@ -47,6 +52,7 @@ template<class T> struct smooth
 	}
 	void link(pnode &a) // Stable links a to a->right
 	{
+		HEAPLINK();
 		pnode b = a->right;
 		if (a->val < b->val)
 		{
@@ -90,15 +96,25 @@ template<class T> struct smooth
 		}
 	}
 
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
+
 	// Main functions
-	void push(pnode a)
+	void push(pnode a) // Inserts a node owned by the caller
 	{
+		a->callerowned = true;
+		HEAPOP(push);
+		HEAPTOUCH(1);
 		sz++;
 		insertIntoHeap(a);
 	}
-	pnode push(T val)
+	pnode push(T val) // The returned node is valid until it is popped
 	{
-		pnode a = _newsmoothnode<T>();
+		HEAPOP(push);
+		HEAPTOUCH(1);
+		pnode a = _newsmoothnode<T>(alloc);
 		a->val = val;
 		sz++;
 		insertIntoHeap(a);
@@ -106,6 +122,8 @@ template<class T> struct smooth
 	}
 	void decreasekey(pnode a, T val)
 	{	
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
 		if (!a->par)
 		{
@@ -114,6 +132,7 @@ template<class T> struct smooth
 		}
 		if (val > a->par->val) return; // A doesn't break heap-order, doesn't need removal
 		// Remove a from its parent
+		HEAPCUT();
 		if (a->left == a) // Only child
 		{
 			a->par->child = nullptr;
@@ -129,10 +148,13 @@ template<class T> struct smooth
 	}
 	void pop()
 	{
+		HEAPOP(pop);
 		sz--;
+		pnode old = root; // Recycled once the pop is done
 		if (!sz)
 		{
 			root = nullptr;
+			reclaim(old);
 			return;
 		}
 		// Remove root
@@ -162,7 +184,11 @@ template<class T> struct smooth
 		x = root;
 		while (x->right)
 		{
-			if (x->val < x->right->val) x = x->right; // x is not a local maximum
+			if (x->val < x->right->val) // x is not a local maximum
+			{
+				HEAPTOUCH(1);
+				x = x->right;
+			}
 			else
 			{
 				bool dolast = 1;
@@ -192,11 +218,15 @@ template<class T> struct smooth
 		}
 		root = x->left = x->right = x;
 		x->par = nullptr;
+		reclaim(old);
 	}
 	void merge(smooth* a)
 	{
 		if (!a->sz) return;
+		HEAPOP(merge);
 		sz += a->sz;
+		alloc.merge(a->alloc); // Nodes of a are now owned by this heap
+		ownshandles = ownshandles && a->ownshandles; // Nodes of a stay valid after pop if a kept them
 		if (!root) // Just set our root to theirs
 		{
 			root = a->root;
@@ -1,22 +1,27 @@
 // Smooth Heap (minimum), one tree
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 template<class T> struct SmoothNode
 {
 	typedef struct SmoothNode<T>* pnode;
 	T val;
 	pnode left, right, child, par; // Left and right siblings in tree/heap, leftmost child, parent
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 	// Need these pointers to support access to: Left & right siblings of a node for removal during decrease-key
 	// + Need parent because leftmost child can no longer store parent because it needs to store rightmost sibling
 };
 // Memory allocation
-template<class T> SmoothNode<T>* _newsmoothnode()
+template<class T, class A> SmoothNode<T>* _newsmoothnode(A &alloc)
 {
-	return new SmoothNode<T>();
+	return alloc.allocate();
 }
-template<class T> struct smooth
+template<class T, template<class> class Alloc = freelistallocator> struct smooth
 {
 	typedef struct SmoothNode<T>* pnode;
+	Alloc<SmoothNode<T> > alloc; // Allocates the nodes of this heap
 	int sz = 0;
 	pnode root = nullptr;
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Auxilary functions
 	int size()
 	{
@@ -38,6 +43,7 @@ template<class T> struct smooth
 			a->par = nullptr;
 			return;
 		}
+		HEAPLINK();
 		if (a->val < root->val)
 		{
 			// Make root a child of a
@@ -77,6 +83,7 @@ template<class T> struct smooth
 	}
 	void link(pnode &a) // Stable links a to a->right
 	{
+		HEAPLINK();
 		pnode b = a->right;
 		if (a->val < b->val)
 		{
@@ -120,15 +127,23 @@ template<class T> struct smooth
 		}
 	}
 
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
+
 	// Main functions
-	void push(pnode a)
+	void push(pnode a) // Inserts a node owned by the caller
 	{
+		a->callerowned = true;
+		HEAPOP(push);
 		sz++;
 		insertIntoHeap(a);
 	}
-	pnode push(T val)
+	pnode push(T val) // The returned node is valid until it is popped
 	{
-		pnode a = _newsmoothnode<T>();
+		HEAPOP(push);
+		pnode a = _newsmoothnode<T>(alloc);
 		a->val = val;
 		sz++;
 		insertIntoHeap(a);
@@ -136,10 +151,13 @@ template<class T> struct smooth
 	}
 	void decreasekey(pnode a, T val)
 	{	
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
 		if (a == root) return; // Is the root, no need to do anything
 		if (val > a->par->val) return; // A doesn't break heap-order, doesn't need removal
 		// Remove a from its parent
+		HEAPCUT();
 		a->left->right = a->right;
 		a->right->left = a->left;
 		if (a->par->child == a)
@@ -152,10 +170,13 @@ template<class T> struct smooth
 	}
 	void pop()
 	{
+		HEAPOP(pop);
 		sz--;
+		pnode old = root; // Recycled once the pop is done
 		if (!sz)
 		{
 			root = nullptr;
+			reclaim(old);
 			return;
 		}
 		// Remove mn
@@ -167,7 +188,11 @@ template<class T> struct smooth
 		x->left = nullptr;
 		while (x->right)
 		{
-			if (x->val < x->right->val) x = x->right; // x is not a local maximum
+			if (x->val < x->right->val) // x is not a local maximum
+			{
+				HEAPTOUCH(1);
+				x = x->right;
+			}
 			else
 			{
 				bool dolast = 1;
@@ -197,11 +222,15 @@ template<class T> struct smooth
 		}
 		root = x;
 		root->par = nullptr;
+		reclaim(old);
 	}
 	void merge(smooth* a)
 	{
 		if (!a->sz) return;
+		HEAPOP(merge);
 		sz += a->sz;
+		alloc.merge(a->alloc); // Nodes of a are now owned by this heap
+		ownshandles = ownshandles && a->ownshandles; // Nodes of a stay valid after pop if a kept them
 		if (!root) // Just set our root to theirs
 		{
 			root = a->root;
@@ -278,7 +278,7 @@ int main()
 	}
 
 	// Start the timer
-	milliseconds start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds start = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	for (int i = 0; i < v; i++) nodes[i] = binomialheapalloc::_newnode(0), nodes[i]->node = i;
 	// Run the algorithm
 	for (int c = 1; c <= v-1; c++) // Run this v-1 times
@@ -333,7 +333,7 @@ int main()
 	printf("%lld\n", ans);
 
 	// End the timer, print the time
-	milliseconds end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+	milliseconds end = duration_cast<milliseconds>(steady_clock::now().time_since_epoch());
 	ll totaltime = end.count() - start.count();
 	printf("Time % 6lldms\n", totaltime);
 }
\ No newline at end of file
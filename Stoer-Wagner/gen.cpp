@@ -30,9 +30,12 @@ struct UF // Union find data structure
 UF uf;
 int main()
 {
-	srand(time(NULL));
 	int v, e;
 	scanf("%d%d", &v, &e);
+	unsigned int seed = time(NULL); // An optional seed can follow, so the same input can be generated again
+	scanf("%u", &seed);
+	srand(seed);
+	fprintf(stderr, "Seed %u\n", seed);
 	printf("%d %d\n", v, e);
 	e-=v-1;
 	assert(e >= 0);
@@ -60,8 +63,7 @@ int main()
 		ll c = (rand()%MXCOST) + 1;
 		edges.push_back({ {a, b}, c } );
 	}
-	random_device rd;
-    mt19937 g(rd());
+    mt19937 g(seed);
 	shuffle(edges.begin(), edges.end(), g);
 	for (auto a : edges)
 	{
@@ -1,5 +1,7 @@
 // Strict fibonacci heap (minimum)
 // Worst case complexities: O(1) push, top, decrease-key, merge, O(log(n)) pop & erase
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 typedef struct ActiveRecord* pactivenode;
 template<class T> struct RanklistNode;
 template<class T> struct FixlistNode;
@@ -15,6 +17,7 @@ template<class T> struct StrictFibonacciNode
 	}
 
 	pnode inheap; // Pointer to the location in the heap which has this value
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 };
 template<class T> struct SFHeapNode // Represents a node in the heap
 {
@@ -57,18 +60,24 @@ template<class T> struct FixlistNode
 	pranklist rank; // Points to the node in the ranklist with this rank
 };
 int counter; // Used to assign indexes to nodes
-template<class T> struct strictfibonacci // The actual heap
+template<class T, template<class> class Alloc = freelistallocator> struct strictfibonacci // The actual heap
 {
 	typedef struct SFHeapNode<T>* pnode;
 	typedef struct RanklistNode<T>* pranklist;
 	typedef struct FixlistNode<T>* pfixlist;
 	typedef struct StrictFibonacciNode<T>* pvalue;
+	// Memory allocation
+	Alloc<SFHeapNode<T> > nodealloc; // Nodes in the heap
+	Alloc<StrictFibonacciNode<T> > valuealloc; // Values
+	Alloc<RanklistNode<T> > rankalloc; // Ranklist nodes
+	Alloc<FixlistNode<T> > fixalloc; // Fix list nodes
 	pnode root;
 	int sz;
 	pactivenode activenode; // Nodes in the heap point here if they are active
 	pnode nonlinkablechild; // Leftmost passive, non linkable child. Otherwise its the rightmost active child. Else nullptr.
 	pnode qfront; // Front of the queue
 	pranklist ranklist; // Rightmost (lowest) node in the ranklist
+	bool ownshandles = true; // Whether popped values it allocated are given back to the allocator. Clear it to keep them valid after pop
 	// Fix list pointers
 	pfixlist one, two, three, four; // Point to leftmost nodes in the four sections of the fix list
 	// All sections are their own separate, linear linked list
@@ -105,6 +114,11 @@ template<class T> struct strictfibonacci // The actual heap
 		a = b;
 		b = c;
 	}
+	void reclaim(pnode x) // Recycles the old root, and its value unless the caller owns it
+	{
+		if (ownshandles && !x->val->callerowned) valuealloc.deallocate(x->val);
+		nodealloc.deallocate(x);
+	}
 	bool isPassiveLinkable(pnode x) // Returns if the node is passive linkable i.e. if it is passive and has only passive children
 	{
 		if (!x) return 0;
@@ -131,6 +145,7 @@ template<class T> struct strictfibonacci // The actual heap
 	// Transformations
 	void link(pnode x, pnode y) // Makes y a child of x
 	{
+		HEAPLINK();
 		assert(y->val->value() > x->val->value());
 		if (y->parent) // If y is not the old root
 		{
@@ -238,6 +253,7 @@ template<class T> struct strictfibonacci // The actual heap
 	void moveSection(pfixlist x, pfixlist &one, pfixlist &two)
 	{
 		// Move x from section 2 to 1
+		HEAPCOUNT(fixlistupdates);
 		if (x->left) x->left->right = x->right;
 		if (x->right) x->right->left = x->left;
 		if (x == two) two = x->right;
@@ -250,6 +266,7 @@ template<class T> struct strictfibonacci // The actual heap
 		// One and two are pointers to the first and second fix lists
 		// Note if this is a insertion due to loss, active should be the loss pointer and one and two should be pointers to the forth and third fix lists
 			
+		HEAPCOUNT(fixlistupdates);
 		a->node->fix = a;
 		if (!count)
 		{
@@ -313,10 +330,12 @@ template<class T> struct strictfibonacci // The actual heap
 			if (!a->active->isactive) link(root, a);
 		}
 
+		fixalloc.deallocate(y); // y is no longer an active root
+
 		// Increase the rank of x by one
 		if (x->rank->left == nullptr) // Need a new node
 		{
-			pranklist newrank = new RanklistNode<T>();
+			pranklist newrank = rankalloc.allocate();
 			newrank->right = x->rank;
 			x->rank->left = newrank;
 		}
@@ -326,6 +345,7 @@ template<class T> struct strictfibonacci // The actual heap
 		x->rank->count++;
 		// Reinsert x into the fix list
 		insertIntoFixList(x, x->rank->active, x->rank->rootcount, one, two);
+		HEAPCOUNT(activerootreductions);
 		return true;
 	}
 	bool rootDegreeReduction() // Reduces the degree of the root by 2, creating one new active root
@@ -349,6 +369,7 @@ template<class T> struct strictfibonacci // The actual heap
 		x->active = y->active = activenode;
 		// x and y have zero loss
 		x->loss = y->loss = 0;
+		x->fix = y->fix = nullptr; // Nodes made passive by a merge can still point into the fix list of their old heap
 		// rank of y becomes zero
 		link(y, z);
 		link(x, y);
@@ -359,7 +380,7 @@ template<class T> struct strictfibonacci // The actual heap
 		pranklist r = ranklist;
 		if (r == nullptr)
 		{
-			r = new RanklistNode<T>();
+			r = rankalloc.allocate();
 			ranklist = r;
 		}
 		y->rank = r;
@@ -367,17 +388,18 @@ template<class T> struct strictfibonacci // The actual heap
 		r = r->left;
 		if (r == nullptr)
 		{
-			r = new RanklistNode<T>();
+			r = rankalloc.allocate();
 			r->right = ranklist;
 			ranklist->left = r;
 		}
 		x->rank = r;
 
 		// insert x into the fix list
-		pfixlist a = new FixlistNode<T>();
+		pfixlist a = fixalloc.allocate();
 		a->node = x;
 		a->rank = x->rank;
 		insertIntoFixList(a, r->active, r->rootcount, one, two);
+		HEAPCOUNT(rootdegreereductions);
 		return true;
 	}
 	void increaseLoss(pnode x) // Increases the loss of x by one
@@ -386,7 +408,7 @@ template<class T> struct strictfibonacci // The actual heap
 		if (x->loss == 1)
 		{
 			// Insert into the fix list
-			pfixlist a = new FixlistNode<T>();
+			pfixlist a = fixalloc.allocate();
 			a->node = x;
 			a->rank = x->rank;
 			assert(x->active->isactive);
@@ -403,6 +425,7 @@ template<class T> struct strictfibonacci // The actual heap
 		{
 			pfixlist a = x->fix;	
 			assert(a);
+			HEAPCOUNT(fixlistupdates);
 			count--;
 			// Update one and two pointers if needed
 			if (a == one) one = a->right;
@@ -426,7 +449,7 @@ template<class T> struct strictfibonacci // The actual heap
 					moveSection(active, two, one);
 				}
 			}
-			delete a;
+			fixalloc.deallocate(a);
 			x->fix = nullptr;
 		}
 	}
@@ -434,6 +457,7 @@ template<class T> struct strictfibonacci // The actual heap
 	void decreaseRank(pnode x)
 	{
 		// Decreases the rank of x by 1
+		HEAPCOUNT(ranklistupdates);
 		if (isActiveRoot(x))
 		{
 			// First, remove from fix list
@@ -449,7 +473,7 @@ template<class T> struct strictfibonacci // The actual heap
 		if (isActiveRoot(x) || x->loss)
 		{
 			// Insert into fix list
-			pfixlist a = new FixlistNode<T>();
+			pfixlist a = fixalloc.allocate();
 			a->node = x;
 			a->rank = x->rank;
 			if (x->loss) insertIntoFixList(a, x->rank->loss, x->rank->losscount, four, three); // Into loss fix list
@@ -459,12 +483,13 @@ template<class T> struct strictfibonacci // The actual heap
 	void increaseRank(pnode x)
 	{
 		// Increases the rank of x by 1
+		HEAPCOUNT(ranklistupdates);
 		// If x has loss, need to remove it from the fix list
 		removeFromFixList(x, x->rank->loss, x->rank->losscount, four, three);
 		
 		if (!x->rank->left) // Need new ranklist node
 		{
-			pranklist a = new RanklistNode<T>();
+			pranklist a = rankalloc.allocate();
 			a->right = x->rank;
 			x->rank->left = a;
 		}
@@ -474,7 +499,7 @@ template<class T> struct strictfibonacci // The actual heap
 		// Insert into fix list
 		if (x->loss) 
 		{
-			pfixlist a = new FixlistNode<T>();
+			pfixlist a = fixalloc.allocate();
 			a->node = x;
 			a->rank = x->rank;
 			insertIntoFixList(a, x->rank->loss, x->rank->losscount, four, three);
@@ -488,7 +513,7 @@ template<class T> struct strictfibonacci // The actual heap
 		x->loss = 0;
 		// x is now an active root
 		// Insert into fix list
-		pfixlist a = new FixlistNode<T>();
+		pfixlist a = fixalloc.allocate();
 		a->node = x;
 		a->rank = x->rank;
 		insertIntoFixList(a, a->rank->active, a->rank->rootcount, one, two);
@@ -512,6 +537,7 @@ template<class T> struct strictfibonacci // The actual heap
 	{
 		if (four)
 		{
+			HEAPCOUNT(lossreductions);
 			if (four->node->loss > 1) // One node loss reduction
 			{
 				pnode x = four->node;
@@ -546,7 +572,7 @@ template<class T> struct strictfibonacci // The actual heap
 	}
 	pnode newNode(pvalue v)
 	{
-		pnode x = new SFHeapNode<T>();
+		pnode x = nodealloc.allocate();
 		v->inheap = x;
 		x->val = v;
 		if (!passive) // If passive does not exist
@@ -554,13 +580,13 @@ template<class T> struct strictfibonacci // The actual heap
 			passive = new ActiveRecord();
 		}
 		x->active = passive; // Node is passive
-		if (!ranklist) ranklist = new RanklistNode<T>(); // If there is no ranklist, make one
+		if (!ranklist) ranklist = rankalloc.allocate(); // If there is no ranklist, make one
 		x->rank = ranklist;
 		return x;
 	}
 	pnode newNode(T val) // returns a pnode with value of val and rank of 0 
 	{
-		pvalue v = new StrictFibonacciNode<T>(); // Create a pointer to the value
+		pvalue v = valuealloc.allocate(); // Create a pointer to the value
 		v->val = val;
 		v->index = counter++;
 		return newNode(v);
@@ -569,6 +595,7 @@ template<class T> struct strictfibonacci // The actual heap
 	// Main operations
 	void push(pnode x)
 	{
+		HEAPOP(push);
 		sz++;
 		if (sz == 1) // only node
 		{
@@ -627,12 +654,13 @@ template<class T> struct strictfibonacci // The actual heap
 			else break; // Not possible, break
 		}
 	}
-	void push(pvalue val)
+	void push(pvalue val) // Inserts a value owned by the caller
 	{
+		val->callerowned = true;
 		val->index = counter++;
 		push(newNode(val));
 	}
-	pvalue push(T val)
+	pvalue push(T val) // The returned value is valid until it is popped
 	{
 		pnode _new = newNode(val);
 		push(_new);
@@ -640,10 +668,17 @@ template<class T> struct strictfibonacci // The actual heap
 	}
 	void decreasekey(pnode x, T val)
 	{
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		x->val->val = val; // Update value
 		if (x->parent == nullptr) return; // If x is the root
+		cut(x, false);
+	}
+	void cut(pnode x, bool minimum) // Makes x, which is not the root, a child of the root. Its value goes to the root if it is smaller
+	{	// With minimum, its value goes to the root anyway and the reductions are left to the pop that must follow
+		HEAPCUT();
 		pnode y = x->parent;
-		if (x->val->value() < root->val->value())
+		if (!minimum && x->val->value() < root->val->value())
 		{
 			// swap values
 			std::swap(x->val, root->val);
@@ -657,7 +692,7 @@ template<class T> struct strictfibonacci // The actual heap
 			removeFromFixList(x, x->rank->loss, x->rank->losscount, four, three);
 			x->loss = 0;
 			// Make x an active root, insert into fix list
-			pfixlist a = new FixlistNode<T>();
+			pfixlist a = fixalloc.allocate();
 			a->node = x;
 			a->rank = x->rank;
 			insertIntoFixList(a, a->rank->active, a->rank->rootcount, one, two);
@@ -668,6 +703,12 @@ template<class T> struct strictfibonacci // The actual heap
 			// Increase the loss of y
 			increaseLoss(y);
 		}
+		if (minimum) // The root now has a child smaller than it, which pop makes the new root
+		{
+			std::swap(x->val, root->val);
+			std::swap(x->val->inheap, root->val->inheap);
+			return;
+		}
 		lossReduction(); // A loss reduction if possible
 		// DO six active root reductions and four root degree reductions, to the extent possible
 		int arrcount = 0;
@@ -685,9 +726,11 @@ template<class T> struct strictfibonacci // The actual heap
 	}
 	void pop()
 	{
+		HEAPOP(pop);
 		sz--;
 		if (sz == 0)
 		{
+			reclaim(root);
 			root = nullptr;
 			qfront = nullptr;
 			return;
@@ -697,6 +740,7 @@ template<class T> struct strictfibonacci // The actual heap
 		pnode a = x;
 		do
 		{
+			HEAPTOUCH(1);
 			if (a->val->value() < x->val->value()) x = a;
 			a = a->right;
 		}
@@ -717,7 +761,7 @@ template<class T> struct strictfibonacci // The actual heap
 					removeFromFixList(a, a->rank->loss, a->rank->losscount, four, three);
 					a->loss = 0;
 					// Insert into fix list
-					pfixlist b = new FixlistNode<T>();
+					pfixlist b = fixalloc.allocate();
 					b->node = a;
 					b->rank = a->rank;
 					insertIntoFixList(b, b->rank->active, b->rank->rootcount, one, two); // Add to active root fix list
@@ -777,7 +821,7 @@ template<class T> struct strictfibonacci // The actual heap
 			}
 		}
 		// Make all other children of the root a child of x
-		delete root;
+		reclaim(root);
 		root = x;
 		x->parent = nullptr;
 		a = x->right;
@@ -789,11 +833,11 @@ template<class T> struct strictfibonacci // The actual heap
 			a = next;
 		}
 		// Remove x from the queue
-		if (qfront == x) qfront = x->qright;
+		if (qfront == x) qfront = x->qright != x ? x->qright : nullptr; // x was the only other node
 		x->qright->qleft = x->qleft;
 		x->qleft->qright = x->qright;
 		// Do this twice
-		for (int i = 0; i < 2; i++)
+		for (int i = 0; i < 2 && qfront; i++)
 		{
 			pnode y = qfront;
 			// Move to back of q
@@ -815,11 +859,14 @@ template<class T> struct strictfibonacci // The actual heap
 	}
 	void erase(pnode x)
 	{
-		// Decrease key to -inf
-		decreasekey(x, -2e9);
-		// Pop
+		// Move the value of x to the root as if it was the minimum, then pop
+		if (x->parent) cut(x, true);
 		pop();
 	}
+	void erase(pvalue x)
+	{
+		erase(x->inheap);
+	}
 
 	void merge(strictfibonacci* x) // Merge operation, seems to be behaving correctly
 	{
@@ -828,6 +875,13 @@ template<class T> struct strictfibonacci // The actual heap
 			// No point merging
 			return;
 		}
+		HEAPOP(merge);
+		// All nodes of x are now owned by this heap
+		nodealloc.merge(x->nodealloc);
+		valuealloc.merge(x->valuealloc);
+		ownshandles = ownshandles && x->ownshandles; // Values of x stay valid after pop if x kept them
+		rankalloc.merge(x->rankalloc);
+		fixalloc.merge(x->fixalloc);
 		if (x->sz > sz) // Swap the heaps
 		{
 			// Set our fix list to x's fix list
@@ -843,6 +897,7 @@ template<class T> struct strictfibonacci // The actual heap
 			{
 				sz = x->sz;
 				root = x->root;
+				nonlinkablechild = x->nonlinkablechild;
 				return;
 			}
 		}
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include "../Allocator/allocator.cpp"
+#include "../Counters/counters.cpp"
 // Minimum violation heap, O(1) push, decrease-key, merge. O(log(n)) pop
 template<class T> struct ViolationNode
 {
@@ -6,23 +8,26 @@ template<class T> struct ViolationNode
 	T val;
 	int rank;
 	bool isRoot;
+	bool callerowned; // Pushed by the caller, so never given back to the allocator
 	pnode child, left, right; // Pointer two leftmost child, right/left nodes in sibling linked list/main linked list
 };
 
-template<class T> ViolationNode<T>* newviolationnode(T val)
+template<class T, class A> ViolationNode<T>* newviolationnode(A &alloc, T val)
 {
 	typedef struct ViolationNode<T>* pnode;
-	pnode _new = new ViolationNode<T>();
+	pnode _new = alloc.allocate();
 	_new->val = val;
 	return _new;
 }
-template<class T> struct violation
+template<class T, template<class> class Alloc = freelistallocator> struct violation
 {
 	typedef struct ViolationNode<T>* pnode;
+	Alloc<ViolationNode<T> > alloc; // Allocates the nodes of this heap
 	pnode root = nullptr; // Pointer to root of heap containing minimum value
 	int sz = 0;
 	pnode _first[50], _second[50]; // Used for intermediary storage during pop
 	int mxrank = 0; // Used for intermediary storage
+	bool ownshandles = true; // Whether popped nodes it allocated are given back to the allocator. Clear it to keep them valid after pop
 	violation()
 	{
 		std::fill_n(_first, 50, nullptr);
@@ -63,6 +68,10 @@ template<class T> struct violation
 		a = b;
 		b = c;
 	}
+	void reclaim(pnode a) // Recycles a node that has left the heap, unless the caller owns it
+	{
+		if (ownshandles && !a->callerowned) alloc.deallocate(a);
+	}
 	void insertIntoHeap(pnode a, pnode &root) // Inserts a into the heap rooted at root
 	{
 		a->isRoot = true;
@@ -102,6 +111,8 @@ template<class T> struct violation
 		else if (c->val <= a->val && c->val <= b->val) swap(a, c); // C is the smallest
 		swapFirstTwoChildren(a); // Ensure old active children of a are sorted by rank
 		// Make b and c children of a
+		HEAPLINK();
+		HEAPLINK();
 		if (a->child) a->child->left = b;
 		b->right = a->child;
 		b->left = c;
@@ -114,15 +125,21 @@ template<class T> struct violation
 	}
 
 	// Main functions
-	void push(pnode a)
+	void push(pnode a) // Inserts a node owned by the caller
 	{
+		a->callerowned = true;
+		HEAPOP(push);
+		HEAPTOUCH(1);
 		sz++;
 		insertIntoHeap(a, root);
 	}
-	pnode push(T val)
+	pnode push(T val) // The returned node is valid until it is popped
 	{
-		pnode _new = newviolationnode<T>(val);
-		push(_new);
+		HEAPOP(push);
+		HEAPTOUCH(1);
+		pnode _new = newviolationnode<T>(alloc, val);
+		sz++;
+		insertIntoHeap(_new, root);
 		return _new;
 	}
 	void merge(pnode a)
@@ -147,12 +164,16 @@ template<class T> struct violation
 	}
 	void merge(violation *a)
 	{
+		HEAPOP(merge);
 		sz += a->sz;
+		alloc.merge(a->alloc); // Nodes of a are now owned by this heap
+		ownshandles = ownshandles && a->ownshandles; // Nodes of a stay valid after pop if a kept them
 		if (!root) root = a->root;
 		else if (a->root) merge(a->root);
 	}
 	void dealWithNode(pnode a) // Does possible merges
 	{
+		HEAPTOUCH(1);
 		int r = a->rank;
 		if (r > mxrank) mxrank = r; // Update maximum seen rank if needed
 		if (!_first[r]) _first[r] = a; // First occurrence of this rank
@@ -167,10 +188,13 @@ template<class T> struct violation
 	}
 	void pop()
 	{
+		HEAPOP(pop);
 		sz--;
+		pnode old = root; // Recycled once the pop is done
 		if (!sz) // Heap is now empty
 		{
 			root = nullptr;
+			reclaim(old);
 			return;
 		}
 		mxrank = 0;
@@ -206,6 +230,7 @@ template<class T> struct violation
 				_second[i] = nullptr;
 			}
 		}
+		reclaim(old);
 	}
 	pnode parent(pnode a)
 	{
@@ -217,6 +242,8 @@ template<class T> struct violation
 	}
 	void decreasekey(pnode a, T val)
 	{
+		HEAPOP(decreasekey);
+		HEAPTOUCH(1);
 		a->val = val;
 		if (a->isRoot)
 		{
@@ -224,6 +251,11 @@ template<class T> struct violation
 			if (a->val < root->val) root = a;
 			return;
 		}
+		cut(a);
+	}
+	void cut(pnode a) // Moves a, which is not a root, into the list of roots
+	{
+		HEAPCUT();
 		swapFirstTwoChildren(a);
 		pnode p = parent(a); // Store the parent of a
 		// Place first child in the place of a
@@ -257,14 +289,16 @@ template<class T> struct violation
 		{
 			int r = rank(p);
 			if (r == p->rank) break; // Done with propagation
+			HEAPTOUCH(1);
 			p->rank = r;
 			p = parent(p);
 		}
 	}
 	void erase(pnode a)
 	{
-		// Decrease key to -inf, then pop
-		decreasekey(a, -2e9);
+		// Make a a root and pop it as if it was the minimum, pop finds the real minimum again
+		if (!a->isRoot) cut(a);
+		root = a;
 		pop();
 	}
 };
\ No newline at end of file